@@ -0,0 +1,131 @@
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "dimacsParsing.h"
+
+/**
+ * Measures parsing of generated random 3-SAT files of growing size, mapped
+ * and streamed, against the getline, istringstream and std::stoi parser the
+ * mapped one replaced. Throughput of the new parsers should not drop with
+ * size, none of them allocates per token.
+ */
+
+/** Former parser, without its validation */
+ParsedDimacsFile parseBySplitting(std::istream& input) {
+  uint32_t varCount = 0;
+  std::vector<int32_t> weights;
+  std::vector<std::vector<int32_t>> clauses;
+  for (std::string line; std::getline(input, line);) {
+    std::vector<std::string> words;
+    std::istringstream iss(line);
+    for (std::string word; std::getline(iss, word, ' ');) {
+      if (!word.empty()) words.push_back(word);
+    }
+    if (words.empty() || words[0] == "c") continue;
+    if (words[0] == "p") {
+      varCount = std::stoi(words[2]);
+    } else if (words[0] == "w") {
+      weights.clear();
+      for (size_t i = 1; i + 1 < words.size(); i++)
+        weights.push_back(std::stoi(words[i]));
+    } else {
+      std::vector<int32_t> clause;
+      for (const std::string& word : words) clause.push_back(std::stoi(word));
+      clause.pop_back();
+      clauses.push_back(clause);
+    }
+  }
+  return {varCount, clauses, weights};
+}
+
+void generate(
+    const std::filesystem::path& path, uint32_t variables, uint32_t clauses
+) {
+  std::mt19937 generator(variables);
+  std::uniform_int_distribution<int32_t> variable(1, variables);
+  std::uniform_int_distribution<int32_t> weight(1, 100);
+  std::bernoulli_distribution negated(0.5);
+  std::ofstream out(path, std::ios::binary);
+  out << fmt::format("c generated\np mwcnf {} {}\nw", variables, clauses);
+  for (uint32_t i = 0; i < variables; i++) out << ' ' << weight(generator);
+  out << " 0\n";
+  for (uint32_t i = 0; i < clauses; i++) {
+    for (int k = 0; k < 3; k++) {
+      int32_t id = variable(generator);
+      out << (negated(generator) ? -id : id) << ' ';
+    }
+    out << "0\n";
+  }
+}
+
+template <typename Parse>
+double medianMs(Parse parse, size_t expectedClauses) {
+  constexpr int repetitions = 3;
+  std::vector<double> times;
+  for (int r = 0; r < repetitions; r++) {
+    auto start = std::chrono::steady_clock::now();
+    ParsedDimacsFile parsed = parse();
+    auto end = std::chrono::steady_clock::now();
+    if (parsed.clauses.size() != expectedClauses) {
+      std::cerr << "Parsed " << parsed.clauses.size() << " clauses"
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    times.push_back(std::chrono::duration<double, std::milli>(end - start)
+                        .count());
+  }
+  std::ranges::sort(times);
+  return times[repetitions / 2];
+}
+
+int main() {
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "parsing_bench.mwcnf";
+  std::cout << std::setw(10) << "variables" << std::setw(8) << "MB"
+            << std::setw(14) << "split MB/s" << std::setw(14) << "stream MB/s"
+            << std::setw(14) << "mapped MB/s" << std::setw(10) << "speedup"
+            << std::endl;
+
+  for (uint32_t variables = 62'500; variables <= 1'000'000; variables *= 4) {
+    uint32_t clauses = 4 * variables;
+    generate(path, variables, clauses);
+    double megabytes =
+        static_cast<double>(std::filesystem::file_size(path)) / 1e6;
+
+    double split = medianMs(
+        [&] {
+          std::ifstream in(path);
+          return parseBySplitting(in);
+        },
+        clauses
+    );
+    double stream = medianMs(
+        [&] {
+          std::ifstream in(path, std::ios::binary);
+          return parseDimacsFile(in);
+        },
+        clauses
+    );
+    double mapped = medianMs([&] { return parseDimacsFile(path); }, clauses);
+
+    std::cout << std::setw(10) << variables << std::setw(8) << std::fixed
+              << std::setprecision(1) << megabytes << std::setw(14)
+              << megabytes * 1e3 / split << std::setw(14)
+              << megabytes * 1e3 / stream << std::setw(14)
+              << megabytes * 1e3 / mapped << std::setw(9)
+              << split / mapped << "x" << std::endl;
+  }
+  std::filesystem::remove(path);
+  return 0;
+}
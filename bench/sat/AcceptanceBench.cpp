@@ -0,0 +1,112 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Cooling.h"
+#include "Rng.h"
+#include "SatConfig.h"
+#include "SatCooling.h"
+#include "SatCriteria.h"
+
+/**
+ * Measures the acceptance decision alone, computed the former way with a
+ * division and exp() against the exponential sample Cooling uses now, and
+ * whole Cooling steps at fixed temperatures where most candidates are
+ * rejected
+ */
+
+constexpr uint32_t decisions = 20'000'000;
+constexpr uint32_t variables = 50'000;
+constexpr uint32_t clauseCount = 210'000;
+constexpr uint32_t steps = 2'000'000;
+
+template <typename Function>
+double nsPer(uint32_t count, Function function) {
+  auto start = std::chrono::steady_clock::now();
+  function();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / count;
+}
+
+void measureDecisions() {
+  // Worse by a few clauses of a large instance, like late in the search
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<int> clauses(1, 4);
+  std::vector<double> worse(1024);
+  for (double& w : worse) w = clauses(generator) / 200'000.0;
+  constexpr double temperature = 1e-5;
+
+  uint32_t acceptedExp = 0;
+  Rng expRng = Rng::fromSeed(1);
+  double expNs = nsPer(decisions, [&] {
+    for (uint32_t i = 0; i < decisions; i++) {
+      double chance = std::exp(-(worse[i % worse.size()] / temperature));
+      acceptedExp += std::fmod(expRng.nextDouble(), 1.0) < chance;
+    }
+  });
+
+  uint32_t acceptedSample = 0;
+  Rng sampleRng = Rng::fromSeed(1);
+  double inverseTemperature = 1 / temperature;
+  double sampleNs = nsPer(decisions, [&] {
+    for (uint32_t i = 0; i < decisions; i++) {
+      acceptedSample += worse[i % worse.size()] * inverseTemperature <
+          sampleRng.nextExponential();
+    }
+  });
+
+  std::cout << std::setw(24) << "decision" << std::setw(12) << "ns"
+            << std::setw(12) << "accepted" << std::endl;
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << std::setw(24) << "exp" << std::setw(12) << expNs
+            << std::setw(12) << acceptedExp << std::endl;
+  std::cout << std::setw(24) << "exponential sample" << std::setw(12)
+            << sampleNs << std::setw(12) << acceptedSample << std::endl;
+}
+
+void measureSteps() {
+  std::mt19937 generator(2);
+  std::uniform_int_distribution<int32_t> variable(1, variables);
+  std::uniform_int_distribution<int32_t> weight(1, 100);
+  std::bernoulli_distribution coin(0.5);
+  std::vector<std::vector<int32_t>> clauses(clauseCount);
+  for (std::vector<int32_t>& clause : clauses) {
+    for (int i = 0; i < 3; i++) {
+      int32_t id = variable(generator);
+      clause.push_back(coin(generator) ? -id : id);
+    }
+  }
+  std::vector<int32_t> weights(variables);
+  for (int32_t& w : weights) w = weight(generator);
+  SatCooling problem(clauses, weights);
+
+  std::cout << std::endl
+            << std::setw(24) << "temperature" << std::setw(12) << "ns/step"
+            << std::endl;
+  for (double temperature : {1e-5, 1e-7}) {
+    CoolingSchedule schedule(
+        UINT32_MAX, 1, temperature, 0, UINT32_MAX, UINT32_MAX, UINT32_MAX
+    );
+    Cooling<SatConfig, SatCriteria, SatCooling> cooling(
+        problem, schedule, Rng::fromSeed(3)
+    );
+    // Settle into the rejecting regime first
+    for (uint32_t i = 0; i < steps; i++) cooling.step();
+    double ns = nsPer(steps, [&] {
+      for (uint32_t i = 0; i < steps; i++) cooling.step();
+    });
+    std::cout << std::setw(24) << std::scientific << std::setprecision(0)
+              << temperature << std::setw(12) << std::fixed
+              << std::setprecision(2) << ns << std::endl;
+  }
+}
+
+int main() {
+  measureDecisions();
+  measureSteps();
+  return 0;
+}
@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Cooling.h"
+#include "Rng.h"
+#include "SatConfig.h"
+#include "SatCooling.h"
+#include "SatCriteria.h"
+
+/**
+ * Measures steps during a burst of betterments, with the best configuration
+ * copied on each of them against journaled flips
+ *
+ * Clauses have only plain literals, so a sparse satisfying start improves
+ * with almost every flip to true at a cold temperature.
+ */
+
+/** SatCooling unable to replay moves, so Cooling copies every new best */
+class EagerSatCooling : private SatCooling {
+ public:
+  using SatCooling::evaluateConfiguration;
+  using SatCooling::evaluateMove;
+  using SatCooling::evaluateProposed;
+  using SatCooling::getRandomConfiguration;
+  using SatCooling::getRandomNeighbor;
+  using SatCooling::Move;
+  using SatCooling::proposeMove;
+  using SatCooling::applyMove;
+  explicit EagerSatCooling(const SatCooling& problem) : SatCooling(problem) {}
+};
+
+template <typename Function>
+double nsPer(uint32_t count, Function function) {
+  auto start = std::chrono::steady_clock::now();
+  function();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / count;
+}
+
+/** Steps as many as twice the variables, about when the burst dies out */
+template <typename Problem>
+void measure(
+    const char* name, const Problem& problem, const SatConfig& start
+) {
+  uint32_t steps = 2 * start.size();
+  CoolingSchedule schedule(
+      UINT32_MAX, 1, 1e-9, 0, UINT32_MAX, UINT32_MAX, UINT32_MAX
+  );
+  Cooling<SatConfig, SatCriteria, Problem> cooling(
+      problem, start, schedule, Rng::fromSeed(3)
+  );
+  double ns = nsPer(steps, [&] { cooling.runSteps(steps); });
+  std::cout << std::setw(12) << name << std::setw(14)
+            << cooling.getBestCriteria().weight() << std::setw(14)
+            << cooling.getStepsSinceBetterment() << std::setw(12)
+            << std::fixed << std::setprecision(2) << ns << std::endl;
+}
+
+int main() {
+  std::cout << std::setw(12) << "variables" << std::setw(12) << "best"
+            << std::setw(14) << "weight" << std::setw(14) << "since best"
+            << std::setw(12) << "ns/step"
+            << std::endl;
+  for (uint32_t variables : {10'000u, 100'000u, 1'000'000u}) {
+    std::mt19937 generator(2);
+    std::uniform_int_distribution<int32_t> variable(1, variables);
+    std::uniform_int_distribution<int32_t> weight(1, 100);
+    std::vector<std::vector<int32_t>> clauses(variables);
+    for (std::vector<int32_t>& clause : clauses) {
+      for (int i = 0; i < 3; i++) clause.push_back(variable(generator));
+    }
+    std::vector<int32_t> weights(variables);
+    for (int32_t& w : weights) w = weight(generator);
+    SatCooling problem(clauses, weights);
+
+    // Satisfy each clause by its first literal
+    SatConfig start(variables);
+    for (const std::vector<int32_t>& clause : clauses) start.set(clause[0], 1);
+
+    std::cout << std::setw(12) << variables;
+    measure("copied", EagerSatCooling(problem), start);
+    std::cout << std::setw(12) << variables;
+    measure("journaled", problem, start);
+  }
+  return 0;
+}
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Cooling.h"
+#include "Portfolio.h"
+#include "Rng.h"
+#include "SatConfig.h"
+#include "SatCooling.h"
+#include "SatCriteria.h"
+#include "SatSharedBest.h"
+
+/**
+ * Measures portfolio chains running independently against chains only
+ * publishing to SatSharedBest, which is the pure cost of sharing, and
+ * chains also restarting from it at every equilibrium, which is the most
+ * often they can
+ *
+ * Chains do a fixed count of steps on a planted satisfiable instance, so
+ * they publish often while finding better configurations. Restarted chains
+ * sit in better configurations, where steps cost differently, so their
+ * time is not only overhead. Reported is the wall time per step of all
+ * chains and the best weight found in the last round.
+ */
+
+constexpr uint32_t variables = 2'000;
+constexpr uint32_t clauseCount = 8'400;
+constexpr uint32_t steps = 2'000'000;
+constexpr uint32_t rounds = 3;
+
+using SatPortfolio = Portfolio<SatConfig, SatCriteria, SatCooling>;
+
+SatCooling makeProblem() {
+  std::mt19937 generator(2);
+  std::uniform_int_distribution<int32_t> variable(1, variables);
+  std::uniform_int_distribution<int32_t> weight(1, 100);
+  std::bernoulli_distribution coin(0.5);
+  std::vector<bool> planted(variables + 1);
+  for (uint32_t id = 1; id <= variables; id++) planted[id] = coin(generator);
+  std::vector<std::vector<int32_t>> clauses(clauseCount);
+  for (std::vector<int32_t>& clause : clauses) {
+    // Resampled until the planted assignment satisfies it
+    do {
+      clause.clear();
+      for (int i = 0; i < 3; i++) {
+        int32_t id = variable(generator);
+        clause.push_back(coin(generator) ? -id : id);
+      }
+    } while (std::ranges::none_of(clause, [&](int32_t literal) {
+      return planted[std::abs(literal)] == (literal > 0);
+    }));
+  }
+  std::vector<int32_t> weights(variables);
+  for (int32_t& w : weights) w = weight(generator);
+  return SatCooling(clauses, weights);
+}
+
+int main() {
+  SatCooling problem = makeProblem();
+  uint32_t threads = std::max(2u, std::thread::hardware_concurrency());
+  CoolingSchedule schedule(
+      10'000, 0.95, 0.001, 1e-9, steps, UINT32_MAX, UINT32_MAX
+  );
+
+  std::cout << std::setw(8) << "threads" << std::setw(14) << "mode"
+            << std::setw(12) << "ns/step" << std::setw(12) << "weight"
+            << std::endl;
+  for (uint32_t restartEvery : {UINT32_MAX, 0u, 1u}) {
+    double bestNs = 1e9;
+    int32_t weight = 0;
+    for (uint32_t round = 0; round < rounds; round++) {
+      SatSharedBest shared(variables);
+      SatPortfolio portfolio(threads);
+      auto start = std::chrono::steady_clock::now();
+      portfolio.run(
+          Rng::fromSeed(round),
+          [&](uint32_t, Rng rng) {
+            return SatPortfolio::Chain(problem, schedule, rng);
+          },
+          [&](SatPortfolio::Chain& chain, uint32_t) {
+            if (restartEvery == UINT32_MAX)
+              chain.simulateCooling();
+            else
+              runCooperating(chain, shared, restartEvery);
+          }
+      );
+      auto end = std::chrono::steady_clock::now();
+      bestNs = std::min(
+          bestNs,
+          std::chrono::duration<double, std::nano>(end - start).count() /
+              (static_cast<double>(steps) * threads)
+      );
+      weight =
+          portfolio.chain(portfolio.bestIndex()).getBestCriteria().weight();
+    }
+    std::cout << std::setw(8) << threads << std::setw(14)
+              << (restartEvery == UINT32_MAX ? "independent"
+                  : restartEvery == 0        ? "publishing"
+                                             : "restarting")
+              << std::fixed
+              << std::setprecision(2) << std::setw(12) << bestNs
+              << std::setw(12) << weight << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Rng.h"
+#include "SatConfig.h"
+#include "SatCooling.h"
+#include "SatEvaluation.h"
+#include "WSatInstance.h"
+
+/**
+ * Compares kernels specialized for uniform clause width against the
+ * generic ones on the same 3-SAT and 5-SAT instances, the generic path is
+ * forced by appending a single clause of another width
+ */
+
+constexpr uint32_t variables = 200'000;
+constexpr uint32_t moves = 200'000;
+
+std::vector<std::vector<int32_t>> generate(uint32_t clauses, uint32_t width) {
+  std::mt19937 generator(width);
+  std::uniform_int_distribution<int32_t> variable(1, variables);
+  std::bernoulli_distribution coin(0.5);
+  std::vector<std::vector<int32_t>> literals(clauses);
+  for (std::vector<int32_t>& clause : literals) {
+    while (clause.size() < width) {
+      int32_t id = variable(generator);
+      if (std::ranges::find_if(clause, [&](int32_t t) {
+            return std::abs(t) == id;
+          }) == clause.end())
+        clause.push_back(coin(generator) ? -id : id);
+    }
+  }
+  return literals;
+}
+
+template <typename Function>
+double medianMs(Function function) {
+  std::vector<double> times;
+  for (int r = 0; r < 5; r++) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+    times.push_back(std::chrono::duration<double, std::milli>(end - start)
+                        .count());
+  }
+  std::ranges::sort(times);
+  return times[times.size() / 2];
+}
+
+void measure(
+    const std::string& name,
+    std::vector<std::vector<int32_t>> clauses,
+    std::vector<int32_t> weights
+) {
+  WSatInstance instance(clauses, weights);
+  SatCooling cooling(clauses, weights);
+  Rng rng = Rng::fromSeed(1);
+  SatConfig config = cooling.getRandomConfiguration(rng);
+  std::vector<uint32_t> counts(instance.clauseCount());
+
+  double full = medianMs([&] {
+    countTrueLiterals(instance, config, counts);
+  });
+  double flips = medianMs([&] {
+    SatConfig current = config;
+    int32_t checksum = cooling.evaluateConfiguration(current).weight();
+    for (uint32_t i = 0; i < moves; i++) {
+      SatCooling::Move move = cooling.proposeMove(current, rng);
+      if (cooling.evaluateMove(current, move).weight() > checksum)
+        cooling.applyMove(current, move);
+    }
+  });
+  std::cout << std::setw(12) << name << std::setw(8)
+            << instance.uniformWidth() << std::fixed << std::setprecision(2)
+            << std::setw(14) << full << std::setw(16) << flips * 1e6 / moves
+            << std::endl;
+}
+
+int main() {
+  std::cout << std::setw(12) << "instance" << std::setw(8) << "width"
+            << std::setw(14) << "full ms" << std::setw(16) << "ns per move"
+            << std::endl;
+  std::vector<int32_t> weights(variables, 1);
+  for (uint32_t width : {3u, 5u}) {
+    // Clause to variable ratios near the satisfiability threshold
+    uint32_t clauseCount = variables * (width == 3 ? 42 : 210) / 10;
+    std::vector<std::vector<int32_t>> clauses = generate(clauseCount, width);
+    std::string name = std::to_string(width) + "-SAT";
+    measure(name, clauses, weights);
+    clauses.push_back({1, 2});
+    measure(name + " mixed", clauses, weights);
+  }
+  return 0;
+}
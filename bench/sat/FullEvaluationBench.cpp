@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "SatConfig.h"
+#include "SatEvaluation.h"
+#include "WSatInstance.h"
+
+/**
+ * Measures full formula evaluation by each kernel on a random 3-SAT
+ * instance with 1M variables and 4M clauses, then the bit-sliced batch
+ * evaluation of 64 assignments at once
+ */
+
+int main() {
+  constexpr uint32_t variables = 1'000'000;
+  constexpr uint32_t clauseCount = 4 * variables;
+  constexpr int repetitions = 20;
+
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<int32_t> variable(1, variables);
+  std::bernoulli_distribution coin(0.5);
+  std::vector<int32_t> weights(variables, 1);
+  std::vector<std::vector<int32_t>> clauses(clauseCount);
+  for (std::vector<int32_t>& clause : clauses) {
+    for (int i = 0; i < 3; i++) {
+      int32_t id = variable(generator);
+      clause.push_back(coin(generator) ? -id : id);
+    }
+  }
+  WSatInstance instance(clauses, weights);
+  std::vector<bool> values(variables);
+  for (uint32_t i = 0; i < variables; i++) values[i] = coin(generator);
+  SatConfig config(values);
+  std::vector<uint32_t> counts(instance.clauseCount());
+
+  // Terms, offsets and counts are streamed, configuration is gathered
+  double bytes = 4.0 * (instance.terms().size() + 2 * instance.clauseCount());
+  for (EvaluationKernel kernel :
+       {EvaluationKernel::Scalar, EvaluationKernel::Avx2}) {
+    if (kernel == EvaluationKernel::Avx2 &&
+        availableKernel() != EvaluationKernel::Avx2) {
+      std::cout << "avx2 not supported" << std::endl;
+      continue;
+    }
+    std::vector<double> times;
+    uint32_t satisfied = 0;
+    for (int r = 0; r < repetitions; r++) {
+      auto start = std::chrono::steady_clock::now();
+      satisfied = countTrueLiterals(instance, config, counts, kernel);
+      satisfied += sumWeights(instance, config, kernel) & 1;
+      auto end = std::chrono::steady_clock::now();
+      times.push_back(std::chrono::duration<double>(end - start).count());
+    }
+    std::ranges::sort(times);
+    double median = times[repetitions / 2];
+    std::cout << (kernel == EvaluationKernel::Scalar ? "scalar" : "avx2  ")
+              << std::fixed << std::setprecision(2) << std::setw(10)
+              << median * 1e3 << " ms" << std::setw(10) << bytes / median / 1e9
+              << " GB/s (checksum " << satisfied << ")" << std::endl;
+  }
+
+  SatConfigBatch batch(variables);
+  for (uint32_t id = 1; id <= variables; id++) {
+    batch.setLanes(id, generator() | uint64_t{generator()} << 32);
+  }
+  std::vector<double> times;
+  uint32_t satisfied = 0;
+  for (int r = 0; r < repetitions / 4; r++) {
+    auto start = std::chrono::steady_clock::now();
+    satisfied = evaluateBatch(instance, batch)[0].satisfied();
+    auto end = std::chrono::steady_clock::now();
+    times.push_back(std::chrono::duration<double>(end - start).count());
+  }
+  std::ranges::sort(times);
+  double median = times[times.size() / 2];
+  std::cout << "batch " << std::setw(11) << median * 1e3 << " ms"
+            << std::setw(10) << median * 1e3 / SatConfigBatch::width
+            << " ms per assignment (checksum " << satisfied << ")"
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "WSatInstance.h"
+#include "dimacsParsing.h"
+
+/**
+ * Measures loading random 3-SAT instances of growing size from text, by
+ * parsing and building them, and from their compiled images, by mapping
+ * and checksumming them. Images load in time linear in their size without
+ * building anything, so they should stay well ahead.
+ */
+
+void generate(
+    const std::filesystem::path& path, uint32_t variables, uint32_t clauses
+) {
+  std::mt19937 generator(variables);
+  std::uniform_int_distribution<int32_t> variable(1, variables);
+  std::uniform_int_distribution<int32_t> weight(1, 100);
+  std::bernoulli_distribution negated(0.5);
+  std::ofstream out(path, std::ios::binary);
+  out << "p mwcnf " << variables << ' ' << clauses << "\nw";
+  for (uint32_t i = 0; i < variables; i++) out << ' ' << weight(generator);
+  out << " 0\n";
+  for (uint32_t i = 0; i < clauses; i++) {
+    for (int k = 0; k < 3; k++) {
+      int32_t id = variable(generator);
+      out << (negated(generator) ? -id : id) << ' ';
+    }
+    out << "0\n";
+  }
+}
+
+template <typename Load>
+double medianMs(Load load) {
+  constexpr int repetitions = 5;
+  std::vector<double> times;
+  for (int r = 0; r < repetitions; r++) {
+    auto start = std::chrono::steady_clock::now();
+    WSatInstance instance = load();
+    auto end = std::chrono::steady_clock::now();
+    if (instance.clauseCount() == 0) std::exit(EXIT_FAILURE);
+    times.push_back(std::chrono::duration<double, std::milli>(end - start)
+                        .count());
+  }
+  std::ranges::sort(times);
+  return times[repetitions / 2];
+}
+
+int main() {
+  std::filesystem::path directory = std::filesystem::temp_directory_path();
+  std::filesystem::path textPath = directory / "image_load_bench.mwcnf";
+  std::filesystem::path imagePath = directory / "image_load_bench.img";
+  std::cout << std::setw(10) << "variables" << std::setw(10) << "text MB"
+            << std::setw(10) << "image MB" << std::setw(12) << "parse ms"
+            << std::setw(12) << "image ms" << std::setw(10) << "speedup"
+            << std::endl;
+
+  for (uint32_t variables = 62'500; variables <= 1'000'000; variables *= 4) {
+    generate(textPath, variables, 4 * variables);
+    auto parse = [&] {
+      WSatInstance::Builder builder;
+      parseDimacsFile(textPath, builder);
+      return std::move(builder).build();
+    };
+    {
+      std::ofstream out(imagePath, std::ios::binary);
+      parse().writeImage(out);
+    }
+
+    double parsed = medianMs(parse);
+    double mapped =
+        medianMs([&] { return WSatInstance::loadImage(imagePath); });
+    std::cout << std::setw(10) << variables << std::setw(10) << std::fixed
+              << std::setprecision(1)
+              << static_cast<double>(file_size(textPath)) / 1e6
+              << std::setw(10)
+              << static_cast<double>(file_size(imagePath)) / 1e6
+              << std::setw(12) << parsed << std::setw(12) << mapped
+              << std::setw(9) << parsed / mapped << "x" << std::endl;
+  }
+  std::filesystem::remove(textPath);
+  std::filesystem::remove(imagePath);
+  return 0;
+}
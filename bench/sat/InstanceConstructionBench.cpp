@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "WSatInstance.h"
+
+/**
+ * Measures WSatInstance construction on random 3-SAT instances of growing
+ * size with a fixed clause to variable ratio. Construction is linear in
+ * total literal count when the time per literal stays flat.
+ */
+
+struct GeneratedInstance {
+  std::vector<std::vector<int32_t>> clauses;
+  std::vector<int32_t> weights;
+};
+
+GeneratedInstance generate(uint32_t variables, uint32_t clauses) {
+  std::mt19937 generator(variables);
+  std::uniform_int_distribution<int32_t> variable(1, variables);
+  std::uniform_int_distribution<int32_t> weight(1, 100);
+  std::bernoulli_distribution negated(0.5);
+
+  GeneratedInstance instance;
+  instance.weights.resize(variables);
+  for (int32_t& w : instance.weights) w = weight(generator);
+  instance.clauses.resize(clauses);
+  for (std::vector<int32_t>& clause : instance.clauses) {
+    for (int i = 0; i < 3; i++) {
+      int32_t id = variable(generator);
+      clause.push_back(negated(generator) ? -id : id);
+    }
+  }
+  return instance;
+}
+
+int main() {
+  constexpr int repetitions = 5;
+  std::cout << std::setw(10) << "variables" << std::setw(10) << "clauses"
+            << std::setw(10) << "literals" << std::setw(12) << "median ms"
+            << std::setw(14) << "ns/literal" << std::endl;
+
+  double firstPerLiteral = 0;
+  double lastPerLiteral = 0;
+  for (uint32_t variables = 12'500; variables <= 200'000; variables *= 2) {
+    GeneratedInstance generated = generate(variables, 4 * variables);
+    std::vector<double> times;
+    uint64_t literals = 0;
+    for (int r = 0; r < repetitions; r++) {
+      auto start = std::chrono::steady_clock::now();
+      WSatInstance instance(generated.clauses, generated.weights);
+      auto end = std::chrono::steady_clock::now();
+      times.push_back(std::chrono::duration<double, std::milli>(end - start)
+                          .count());
+      literals = instance.terms().size();
+    }
+    std::ranges::sort(times);
+    double median = times[repetitions / 2];
+    double perLiteral = median * 1e6 / static_cast<double>(literals);
+    if (firstPerLiteral == 0) firstPerLiteral = perLiteral;
+    lastPerLiteral = perLiteral;
+
+    std::cout << std::setw(10) << variables << std::setw(10) << 4 * variables
+              << std::setw(10) << literals << std::setw(12) << std::fixed
+              << std::setprecision(2) << median << std::setw(14)
+              << perLiteral << std::endl;
+  }
+  std::cout << "Time per literal grew " << std::setprecision(2)
+            << lastPerLiteral / firstPerLiteral
+            << "x while instance grew 16x" << std::endl;
+  return 0;
+}
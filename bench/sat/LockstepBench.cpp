@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Cooling.h"
+#include "Rng.h"
+#include "SatConfig.h"
+#include "SatCooling.h"
+#include "SatCriteria.h"
+#include "SatLockstep.h"
+#include "WSatInstance.h"
+
+/**
+ * Measures Lanes chains run one after another by Cooling against the same
+ * count of lanes advanced in lockstep by SatLockstep, per step of a chain
+ *
+ * The small instance fits in cache, where the shared random numbers and
+ * acceptance decisions show, the large one is bound by memory, where
+ * interleaving the lanes hides some latency. Chains cool so slowly the
+ * temperature stays put and stop after a fixed count of steps.
+ */
+
+constexpr uint32_t steps = 500'000;
+constexpr uint32_t rounds = 5;
+
+using SatChain = Cooling<SatConfig, SatCriteria, SatCooling>;
+
+template <typename Function>
+double nsPer(uint32_t count, Function function) {
+  auto start = std::chrono::steady_clock::now();
+  function();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / count;
+}
+
+std::shared_ptr<const WSatInstance> makeInstance(uint32_t variables) {
+  std::mt19937 generator(2);
+  std::uniform_int_distribution<int32_t> variable(
+      1, static_cast<int32_t>(variables)
+  );
+  std::uniform_int_distribution<int32_t> weight(1, 100);
+  std::bernoulli_distribution coin(0.5);
+  std::vector<std::vector<int32_t>> clauses(variables * 42 / 10);
+  for (std::vector<int32_t>& clause : clauses) {
+    for (int i = 0; i < 3; i++) {
+      int32_t id = variable(generator);
+      clause.push_back(coin(generator) ? -id : id);
+    }
+  }
+  std::vector<int32_t> weights(variables);
+  for (int32_t& w : weights) w = weight(generator);
+  return std::make_shared<const WSatInstance>(clauses, weights);
+}
+
+template <uint32_t Lanes>
+void compare(
+    const std::shared_ptr<const WSatInstance>& instance, uint32_t variables
+) {
+  SatCooling problem(instance);
+  CoolingSchedule schedule(
+      10'000, 1 - 1e-9, 1e-5, 0, steps, UINT32_MAX, UINT32_MAX
+  );
+  double sequentialNs = 1e9;
+  double lockstepNs = 1e9;
+  for (uint32_t round = 0; round < rounds; round++) {
+    std::vector<SatChain> chains;
+    Rng rng = Rng::fromSeed(3);
+    for (uint32_t k = 0; k < Lanes; k++) {
+      chains.emplace_back(problem, schedule, rng);
+      rng.jump();
+    }
+    sequentialNs = std::min(sequentialNs, nsPer(Lanes * steps, [&] {
+                              for (SatChain& chain : chains)
+                                chain.simulateCooling();
+                            }));
+
+    SatLockstep<Lanes> lockstep(instance, schedule, Rng::fromSeed(3));
+    lockstepNs = std::min(lockstepNs, nsPer(Lanes * steps, [&] {
+                            lockstep.simulateCooling();
+                          }));
+  }
+  std::cout << std::setw(10) << variables << std::setw(8) << Lanes
+            << std::fixed << std::setprecision(2) << std::setw(16)
+            << sequentialNs << std::setw(14) << lockstepNs << std::setw(10)
+            << 100 * (sequentialNs - lockstepNs) / sequentialNs << std::endl;
+}
+
+int main() {
+  std::cout << std::setw(10) << "variables" << std::setw(8) << "lanes"
+            << std::setw(16) << "sequential ns" << std::setw(14)
+            << "lockstep ns" << std::setw(10) << "gain %" << std::endl;
+  for (uint32_t variables : {2'000u, 1'000'000u}) {
+    std::shared_ptr<const WSatInstance> instance = makeInstance(variables);
+    compare<4>(instance, variables);
+    compare<8>(instance, variables);
+  }
+  return 0;
+}
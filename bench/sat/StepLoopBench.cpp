@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Cooling.h"
+#include "Rng.h"
+#include "SatConfig.h"
+#include "SatCooling.h"
+#include "SatCriteria.h"
+
+/**
+ * Measures driving Cooling one step() at a time, which checks every stop
+ * condition per step, against runEquilibrium(), which checks them only when
+ * they may have changed, on identical chains
+ *
+ * The instance fits in cache, so steps are cheap and the loop around them
+ * shows. Rounds alternate between the two and the fastest is reported.
+ */
+
+constexpr uint32_t variables = 2'000;
+constexpr uint32_t clauseCount = 8'400;
+constexpr uint32_t steps = 2'000'000;
+constexpr uint32_t rounds = 7;
+
+using SatChain = Cooling<SatConfig, SatCriteria, SatCooling>;
+
+template <typename Function>
+double nsPer(uint32_t count, Function function) {
+  auto start = std::chrono::steady_clock::now();
+  function();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / count;
+}
+
+SatCooling makeProblem() {
+  std::mt19937 generator(2);
+  std::uniform_int_distribution<int32_t> variable(1, variables);
+  std::uniform_int_distribution<int32_t> weight(1, 100);
+  std::bernoulli_distribution coin(0.5);
+  std::vector<std::vector<int32_t>> clauses(clauseCount);
+  for (std::vector<int32_t>& clause : clauses) {
+    for (int i = 0; i < 3; i++) {
+      int32_t id = variable(generator);
+      clause.push_back(coin(generator) ? -id : id);
+    }
+  }
+  std::vector<int32_t> weights(variables);
+  for (int32_t& w : weights) w = weight(generator);
+  return SatCooling(clauses, weights);
+}
+
+int main() {
+  SatCooling problem = makeProblem();
+
+  std::cout << std::setw(12) << "temperature" << std::setw(14) << "equilibrium"
+            << std::setw(14) << "step() ns" << std::setw(14)
+            << "batched ns" << std::setw(10) << "gain %" << std::endl;
+  for (double temperature : {1e-5, 1e-7}) {
+    for (uint32_t equilibrium : {100u, 10'000u}) {
+      // Cools so slowly the temperature stays put, but equilibria end
+      CoolingSchedule schedule(
+          equilibrium,
+          1 - 1e-9,
+          temperature,
+          0,
+          UINT32_MAX,
+          UINT32_MAX,
+          UINT32_MAX
+      );
+      SatChain stepped(problem, schedule, Rng::fromSeed(3));
+      // Settle into the rejecting regime first
+      stepped.runSteps(steps);
+      SatChain batched = stepped;
+
+      double steppedNs = 1e9;
+      double batchedNs = 1e9;
+      for (uint32_t round = 0; round < rounds; round++) {
+        uint32_t until = stepped.getStepsTotal() + steps;
+        steppedNs = std::min(steppedNs, nsPer(steps, [&] {
+                               while (stepped.getStepsTotal() < until)
+                                 stepped.step();
+                             }));
+        batchedNs = std::min(
+            batchedNs, nsPer(steps, [&] { batched.runSteps(steps); })
+        );
+      }
+      if (stepped.getCurrentConfiguration() !=
+          batched.getCurrentConfiguration()) {
+        std::cerr << "Chains diverged" << std::endl;
+        return 1;
+      }
+      std::cout << std::scientific << std::setprecision(0) << std::setw(12)
+                << temperature << std::setw(14) << equilibrium << std::fixed
+                << std::setprecision(2) << std::setw(14) << steppedNs
+                << std::setw(14) << batchedNs << std::setw(10)
+                << 100 * (steppedNs - batchedNs) / steppedNs << std::endl;
+    }
+  }
+  return 0;
+}
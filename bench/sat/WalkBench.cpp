@@ -0,0 +1,90 @@
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Cooling.h"
+#include "Rng.h"
+#include "SatConfig.h"
+#include "SatCooling.h"
+#include "SatCriteria.h"
+
+/**
+ * Counts steps until the current configuration first satisfies a random
+ * 3-SAT instance with a planted solution, for several walk probabilities
+ */
+
+constexpr uint32_t variables = 5'000;
+constexpr uint32_t clauseCount = 20'000;
+constexpr uint32_t maxSteps = 20'000'000;
+
+struct GeneratedInstance {
+  std::vector<std::vector<int32_t>> clauses;
+  std::vector<int32_t> weights;
+};
+
+/** Clauses violated by the planted solution are rejected */
+GeneratedInstance generatePlanted(uint32_t seed) {
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<int32_t> variable(1, variables);
+  std::uniform_int_distribution<int32_t> weight(1, 100);
+  std::bernoulli_distribution coin(0.5);
+  std::vector<bool> planted(variables + 1);
+  for (uint32_t id = 1; id <= variables; id++) planted[id] = coin(generator);
+
+  GeneratedInstance instance;
+  for (uint32_t i = 0; i < variables; i++)
+    instance.weights.push_back(weight(generator));
+  while (instance.clauses.size() < clauseCount) {
+    std::vector<int32_t> clause;
+    bool satisfied = false;
+    for (int i = 0; i < 3; i++) {
+      int32_t id = variable(generator);
+      bool negated = coin(generator);
+      satisfied = satisfied || planted[id] != negated;
+      clause.push_back(negated ? -id : id);
+    }
+    if (satisfied) instance.clauses.push_back(clause);
+  }
+  return instance;
+}
+
+uint32_t stepsToSatisfied(
+    const GeneratedInstance& instance, double walkProbability, uint64_t seed
+) {
+  SatCooling problem(instance.clauses, instance.weights, walkProbability);
+  CoolingSchedule schedule(
+      2'000, 0.99, 1e-3, 1e-7, maxSteps, UINT32_MAX, UINT32_MAX
+  );
+  Cooling<SatConfig, SatCriteria, SatCooling> cooling(
+      problem, schedule, Rng::fromSeed(seed)
+  );
+  while (cooling.step()) {
+    if (cooling.getCurrentCriteria().isSatisfied())
+      return cooling.getStepsTotal();
+  }
+  return maxSteps;
+}
+
+int main() {
+  constexpr int seeds = 5;
+  std::cout << std::setw(8) << "p";
+  for (int s = 0; s < seeds; s++) std::cout << std::setw(12) << "seed " << s;
+  std::cout << std::setw(12) << "mean" << std::endl;
+
+  for (double walkProbability : {0.0, 0.2, 0.4, 0.6}) {
+    std::cout << std::setw(8) << walkProbability;
+    double sum = 0;
+    for (int s = 0; s < seeds; s++) {
+      GeneratedInstance instance = generatePlanted(s);
+      uint32_t steps = stepsToSatisfied(instance, walkProbability, s + 1);
+      sum += steps;
+      std::cout << std::setw(13) << steps;
+    }
+    std::cout << std::setw(12) << static_cast<uint64_t>(sum / seeds)
+              << std::endl;
+  }
+  std::cout << "(" << maxSteps << " means not satisfied)" << std::endl;
+  return 0;
+}
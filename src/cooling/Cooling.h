@@ -1,41 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <concepts>
 #include <cstdint>
 #include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <utility>
 
+#include "CoolingSchedule.h"
+#include "MoveJournal.h"
 #include "Rng.h"
 #include "debug.h"
 
-/** Data controlling the schedule of cooling and how long the search lasts */
-struct CoolingSchedule {
-  /// @name Temperature control
-  ///@{
-  double startTemperature;
-  double coolingFactor;
-  /** How many steps before cooling the temperature */
-  uint32_t equilibrium;
-  ///@}
-
-  /// @name Stop control
-  ///@{
-  double stopTemperature;
-  uint32_t stopAfterTotalSteps;
-  uint32_t stopAfterNoChange;
-  uint32_t stopAfterNoBetterment;
-  ///@}
-
-  CoolingSchedule(
-      uint32_t equilibrium,
-      double coolingFactor,
-      double startTemperature,
-      double stopTemperature,
-      uint32_t stopAfterTotalSteps,
-      uint32_t stopAfterNoChange,
-      uint32_t stopAfterNoBetterment
-  );
-};
 /**
  * Generic simulated cooling solver
  * Requires a Problem, Configuration and Optimization Criteria
@@ -56,15 +35,43 @@ class Configuration {
   bool operator==(const Configuration& other) const;
   bool operator!=(const Configuration& other) const;
 };
+/** Draws random numbers from the Rng of the Cooling it serves */
 class Problem {
  public:
-  [[nodiscard]] Configuration getRandomConfiguration() const;
+  [[nodiscard]] Configuration getRandomConfiguration(Rng& rng) const;
   [[nodiscard]] Configuration getRandomNeighbor(
-      const Configuration& configuration
+      const Configuration& configuration, Rng& rng
   ) const;
   [[nodiscard]] Criteria evaluateConfiguration(
       const Configuration& configuration
   ) const;
+  /**
+   * Optional, criteria of the neighbor the last getRandomNeighbor()
+   * returned, passed unchanged and before any other evaluation, which the
+   * problem may score from what it remembers of proposing it
+   */
+  [[nodiscard]] Criteria evaluateProposed(const Configuration& neighbor);
+};
+/**
+ * Problem able to change a configuration in place, which spares Cooling
+ * from copying the whole configuration on every step
+ */
+class MoveProblem : public Problem {
+ public:
+  /** Small description of a change to a configuration */
+  using Move = int;
+  [[nodiscard]] Move proposeMove(const Configuration& configuration, Rng& rng);
+  /** Criteria of configuration, if the move was applied to it */
+  [[nodiscard]] Criteria evaluateMove(
+      const Configuration& configuration, const Move& move
+  );
+  void applyMove(Configuration& configuration, const Move& move);
+  /**
+   * Optional, changes configuration like applyMove() without touching any
+   * state of the problem, which lets Cooling journal moves since the best
+   * configuration instead of copying it on every betterment
+   */
+  void replayMove(Configuration& configuration, const Move& move) const;
 };
 
 template <typename T>
@@ -81,82 +88,231 @@ concept Criteriable = std::copy_constructible<T> && requires(T t1, T t2) {
 };
 
 template <typename T, typename Configuration, typename Criteria>
-concept Problemable = requires(T t, Configuration configuration) {
-  { t.getRandomConfiguration() } -> std::convertible_to<Configuration>;
-  { t.getRandomNeighbor(configuration) } -> std::convertible_to<Configuration>;
+concept Problemable = requires(T t, Configuration configuration, Rng rng) {
+  { t.getRandomConfiguration(rng) } -> std::convertible_to<Configuration>;
+  {
+    t.getRandomNeighbor(configuration, rng)
+  } -> std::convertible_to<Configuration>;
   { t.evaluateConfiguration(configuration) } -> std::convertible_to<Criteria>;
 };
 
+/**
+ * Optional extension of Problemable, Cooling detects it and scores each
+ * neighbor by Problem::evaluateProposed() right after proposing it
+ */
+template <typename T, typename Configuration, typename Criteria>
+concept ProposedProblemable = Problemable<T, Configuration, Criteria> &&
+    requires(T t, const Configuration& neighbor) {
+      { t.evaluateProposed(neighbor) } -> std::convertible_to<Criteria>;
+    };
+
+/**
+ * Optional extension of Problemable, Cooling detects it and proposes moves
+ * applied in place instead of copying whole neighbors
+ *
+ * Rejected moves are simply discarded, every configuration passed in is the
+ * one the moves were applied to since it was last evaluated
+ */
+template <typename T, typename Configuration, typename Criteria>
+concept MoveProblemable = Problemable<T, Configuration, Criteria> &&
+    requires(
+        T t, Configuration configuration, Rng rng, const typename T::Move& move
+    ) {
+      {
+        t.proposeMove(configuration, rng)
+      } -> std::convertible_to<typename T::Move>;
+      {
+        t.evaluateMove(configuration, move)
+      } -> std::convertible_to<Criteria>;
+      { t.applyMove(configuration, move) };
+    };
+
+/** Optional extension of MoveProblemable, see MoveProblem::replayMove() */
+template <typename T, typename Configuration, typename Criteria>
+concept JournalProblemable = MoveProblemable<T, Configuration, Criteria> &&
+    requires(
+        const T t, Configuration configuration, const typename T::Move& move
+    ) {
+      { t.replayMove(configuration, move) };
+    };
+
+/** Stands in for the MoveJournal of problems unable to replay moves */
+struct NoJournal {};
+
+template <typename Problem, typename Configuration, typename Criteria>
+struct JournalFor {
+  using type = NoJournal;
+};
+template <typename Problem, typename Configuration, typename Criteria>
+  requires JournalProblemable<Problem, Configuration, Criteria>
+struct JournalFor<Problem, Configuration, Criteria> {
+  using type = MoveJournal<typename Problem::Move>;
+};
+
+/**
+ * Optional extension of Problemable, lets Cooling write a checkpoint of the
+ * search and resume it bit-exactly
+ *
+ * Search state is whatever the Problem keeps between steps which influences
+ * the following ones, readSearchState() restores it from writeSearchState()
+ * of a problem created from the same instance.
+ */
+template <typename T, typename Configuration>
+concept CheckpointProblemable = requires(
+    T t,
+    const T constT,
+    const Configuration& configuration,
+    std::ostream& out,
+    std::istream& in
+) {
+  { constT.writeConfiguration(out, configuration) };
+  { constT.readConfiguration(in) } -> std::convertible_to<Configuration>;
+  { constT.writeSearchState(out) };
+  { t.readSearchState(in) };
+};
+
 /**
  * Searches for best Criteria producing Configuration solving a given Problem
  * bounded by provided CoolingSchedule
  *
  * Ownership
  *  - Problem owns his own data and returns copies
+ *  - MoveProblem changes the current configuration in place
  *  - Cooling owns his own copies of Problem data and returns copies
+ *  - Cooling owns the Rng and lends it to the Problem
+ *  - Best configuration of a JournalProblem is materialized lazily, even by
+ *    const accessors, so a Cooling must not be read while it runs
  *
  * What is not great:
  *  - Configuration != State
  *  - Probably missing abstraction search ending - at the moment a lot of values
- *  - Cool and frozen could be functors
- *  - Schedule seems too rigid
+ *    and flags
+ *  - Frozen could be a functor
  */
-template <Configurable Configuration, Criteriable Criteria, typename Problem>
+template <
+    Configurable Configuration,
+    Criteriable Criteria,
+    typename Problem,
+    SchedulePolicy Schedule = GeometricCooling>
   requires Problemable<Problem, Configuration, Criteria>
 class Cooling {
  private:
   // Inputs
   CoolingSchedule schedule;
+  Schedule policy;
   Problem problem;
+  Rng rng;
 
   // Search state
+  static constexpr bool journaled =
+      JournalProblemable<Problem, Configuration, Criteria>;
   Configuration currentConfig;
-  Configuration bestConfig;
+  /** Snapshot the journal replays on to get the best configuration */
+  mutable Configuration bestConfig;
+  [[no_unique_address]] mutable
+      typename JournalFor<Problem, Configuration, Criteria>::type journal;
   Criteria currentCriteria;
   Criteria bestCriteria;
   double temperature;
+  /**
+   * Cached 1 / temperature, so steps call no exp() or fmod() and only
+   * divide once, inside Rng::nextExponential()
+   */
+  double inverseTemperature;
 
   // Changes with equilibrium
   uint32_t stepsTotal = 0;
   // Changes with equilibrium
   uint32_t stepsInEquilibrium = 0;
+  // Changes with equilibrium
+  uint32_t acceptedInEquilibrium = 0;
   // Changes when we accept next candidate
   uint32_t stepsSinceChange = 0;
   // Changes when accepted candidate is better
   uint32_t stepsSinceBetterment = 0;
 
+  // Stop conditions beyond the step counters
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point deadline;
+  bool deadlinePassed = false;
+  std::optional<Criteria> target;
+  bool targetReached = false;
+
+  static constexpr uint32_t checkpointMagic = 0x4B434357;  // "WCCK"
+  static constexpr uint32_t checkpointVersion = 1;
+
+  template <typename T>
+  static void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  template <typename T>
+  static T readValue(std::istream& in) {
+    T value;
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+      throw std::invalid_argument("Checkpoint ended unexpectedly");
+    return value;
+  }
+
+  static Clock::time_point deadlineAfter(Clock::duration budget) {
+    Clock::time_point now = Clock::now();
+    if (budget >= Clock::time_point::max() - now)
+      return Clock::time_point::max();
+    return now + budget;
+  }
+
  public:
   [[nodiscard]] uint32_t getStepsTotal() const { return stepsTotal; }
+  /** 0 right after an equilibrium ended */
+  [[nodiscard]] uint32_t getStepsInEquilibrium() const {
+    return stepsInEquilibrium;
+  }
   [[nodiscard]] uint32_t getStepsSinceChange() const {
     return stepsSinceChange;
   }
   [[nodiscard]] uint32_t getStepsSinceBetterment() const {
     return stepsSinceBetterment;
   }
-  Cooling(Problem problem, Configuration start, const CoolingSchedule& schedule)
+  Cooling(
+      Problem problem,
+      Configuration start,
+      const CoolingSchedule& schedule,
+      Rng rng
+  )
       : schedule(schedule),
+        policy(schedule),
         problem(problem),
+        rng(rng),
         currentConfig(start),
         bestConfig(start),
-        temperature(schedule.startTemperature) {
-    currentCriteria = problem.evaluateConfiguration(currentConfig);
+        temperature(schedule.startTemperature),
+        inverseTemperature(1 / temperature),
+        deadline(deadlineAfter(schedule.stopAfterTime)) {
+    currentCriteria = this->problem.evaluateConfiguration(currentConfig);
     bestCriteria = currentCriteria;
   }
   /** Starting config is chosen at random  */
-  Cooling(Problem problem, const CoolingSchedule& schedule)
+  Cooling(Problem problem, const CoolingSchedule& schedule, Rng rng)
       : schedule(schedule),
+        policy(schedule),
         problem(problem),
-        temperature(schedule.startTemperature) {
-    currentConfig = problem.getRandomConfiguration();
+        rng(rng),
+        temperature(schedule.startTemperature),
+        inverseTemperature(1 / temperature),
+        deadline(deadlineAfter(schedule.stopAfterTime)) {
+    currentConfig = this->problem.getRandomConfiguration(this->rng);
     bestConfig = currentConfig;
-    currentCriteria = problem.evaluateConfiguration(currentConfig);
+    currentCriteria = this->problem.evaluateConfiguration(currentConfig);
     bestCriteria = currentCriteria;
   }
 
   /** @name Schedule */
   ///@{
   [[nodiscard]] bool isFrozen() const {
-    if (temperature <= schedule.stopTemperature) {
+    if (targetReached) {
+      DEBUG_PRINT("Ended because of reaching the target")
+    } else if (deadlinePassed) {
+      DEBUG_PRINT("Ended because of time")
+    } else if (temperature <= schedule.stopTemperature) {
       DEBUG_PRINT("Ended because of temperature")
     } else if (schedule.stopAfterTotalSteps <= stepsTotal) {
       DEBUG_PRINT("Ended because of max steps")
@@ -170,6 +326,12 @@ class Cooling {
     return true;
   }
   [[nodiscard]] std::string endedBecause() const {
+    if (targetReached) {
+      return "target";
+    }
+    if (deadlinePassed) {
+      return "time";
+    }
     if (temperature <= schedule.stopTemperature) {
       return "temperature";
     }
@@ -188,6 +350,20 @@ class Cooling {
   [[nodiscard]] const CoolingSchedule& coolingSchedule() const {
     return schedule;
   }
+  [[nodiscard]] double getTemperature() const { return temperature; }
+  /** Lets an outer engine, like ParallelTempering, drive the temperature */
+  void setTemperature(double temperature) {
+    this->temperature = temperature;
+    inverseTemperature = 1 / temperature;
+  }
+  /**
+   * Ends the search once a valid configuration at least as good as target
+   * is found
+   */
+  void setTarget(const Criteria& target) {
+    this->target = target;
+    targetReached = bestCriteria.isValid() && bestCriteria >= target;
+  }
   ///@}
 
   /// @name Search execution
@@ -195,12 +371,7 @@ class Cooling {
   /** Does one step in equilibrium @return true if search not over */
   bool step() {
     if (isFrozen()) return false;
-    // Is equilibrium over?
-    if (stepsInEquilibrium >= schedule.equilibrium) {
-      temperature = temperature * schedule.coolingFactor;
-      stepsInEquilibrium = 0;
-      return true;
-    }
+    if (endEquilibriumIfOver()) return true;
 
     // Update steps
     stepsInEquilibrium++;
@@ -208,51 +379,276 @@ class Cooling {
     stepsSinceBetterment++;
     stepsSinceChange++;
 
-    Configuration candidate = problem.getRandomNeighbor(currentConfig);
-    Criteria candidateCriteria = problem.evaluateConfiguration(candidate);
-
-    double candidateWorse = candidateCriteria.howMuchWorseThan(currentCriteria);
-
-    DEBUG_PRINT("Candidate: " << candidateCriteria)
-    DEBUG_PRINT("Current: " << currentCriteria)
-    DEBUG_PRINT("CandidateWorse" << candidateWorse)
+    Outcome outcome = tryCandidate();
+    if (outcome != Outcome::rejected) {
+      stepsSinceChange = 0;
+      acceptedInEquilibrium++;
+    }
+    if (outcome == Outcome::bettered) stepsSinceBetterment = 0;
+    return true;
+  }
 
-    // If better
-    if (candidateWorse <= 0) {
-      swapCandidate(candidate, candidateCriteria);
-      return true;
+  /**
+   * Does count steps, or less if the search ends, checking stop conditions
+   * only when they may have changed
+   *
+   * Goes through the same states as count calls of step(), except that
+   * ends of equilibria are not counted.
+   *
+   * @return true if search not over
+   */
+  bool runSteps(uint32_t count) {
+    while (count > 0) {
+      if (isFrozen()) return false;
+      if (endEquilibriumIfOver()) continue;
+      count -= runBatch(std::min(count, stepsBeforeCheck()));
     }
-    // else: decide if we want to apply the less good candidate anyway
+    return notFrozen();
+  }
 
-    double acceptChance = std::exp(-(candidateWorse / temperature));
-    DEBUG_PRINT("Accept chance: " << acceptChance << "%")
-    if (Rng::nextDoublePercent() < acceptChance) {
-      swapCandidate(candidate, candidateCriteria);
+  /**
+   * Does steps until the current equilibrium ends, including its end
+   *
+   * @return true if search not over
+   */
+  bool runEquilibrium() {
+    while (true) {
+      if (isFrozen()) return false;
+      if (endEquilibriumIfOver()) return true;
+      runBatch(stepsBeforeCheck());
     }
-    return true;
   }
 
   /** Does as many step as necessary to end the search */
   void simulateCooling() {
-    while (step()) {
+    while (runEquilibrium()) {
     }
   }
 
+  /**
+   * Continues the search from given configuration, like a migrant from
+   * another search, which also becomes the best one if it is
+   *
+   * Temperature and step counters are kept, only the counter since change
+   * starts over.
+   */
+  void moveTo(const Configuration& configuration) {
+    materializeBest();
+    if constexpr (journaled) journal.stop();
+    currentConfig = configuration;
+    currentCriteria = problem.evaluateConfiguration(currentConfig);
+    stepsSinceChange = 0;
+    if (bestCriteria.howMuchWorseThan(currentCriteria) <= 0 ||
+        !currentCriteria.isValid())
+      return;
+    bestConfig = currentConfig;
+    if constexpr (journaled) journal.restart();
+    bestCriteria = currentCriteria;
+    stepsSinceBetterment = 0;
+    if (target && bestCriteria >= *target) targetReached = true;
+  }
+
+  /**
+   * Writes everything the search depends on, but the problem instance,
+   * the schedule and the stop conditions, in native byte order
+   */
+  void saveCheckpoint(std::ostream& out) const
+    requires CheckpointProblemable<Problem, Configuration>
+  {
+    writeValue(out, checkpointMagic);
+    writeValue(out, checkpointVersion);
+    writeValue(out, temperature);
+    writeValue(out, stepsTotal);
+    writeValue(out, stepsInEquilibrium);
+    writeValue(out, acceptedInEquilibrium);
+    writeValue(out, stepsSinceChange);
+    writeValue(out, stepsSinceBetterment);
+    writeValue(out, rng.state());
+    problem.writeConfiguration(out, currentConfig);
+    problem.writeConfiguration(out, getBestConfiguration());
+    problem.writeSearchState(out);
+  }
+
+  /**
+   * Continues the search from saveCheckpoint() of a Cooling with the same
+   * problem and schedule, as if it was never interrupted
+   *
+   * Criteria are evaluated anew, which the incremental evaluation must
+   * match exactly. Time budget starts over and the target is kept.
+   *
+   * @throws std::invalid_argument on a malformed checkpoint
+   */
+  void loadCheckpoint(std::istream& in)
+    requires CheckpointProblemable<Problem, Configuration>
+  {
+    if (readValue<uint32_t>(in) != checkpointMagic)
+      throw std::invalid_argument("Not a cooling checkpoint");
+    if (readValue<uint32_t>(in) != checkpointVersion)
+      throw std::invalid_argument("Unsupported checkpoint version");
+    setTemperature(readValue<double>(in));
+    stepsTotal = readValue<uint32_t>(in);
+    stepsInEquilibrium = readValue<uint32_t>(in);
+    acceptedInEquilibrium = readValue<uint32_t>(in);
+    stepsSinceChange = readValue<uint32_t>(in);
+    stepsSinceBetterment = readValue<uint32_t>(in);
+    rng.setState(readValue<Rng::State>(in));
+    currentConfig = problem.readConfiguration(in);
+    bestConfig = problem.readConfiguration(in);
+    if constexpr (journaled) journal.stop();
+    bestCriteria = problem.evaluateConfiguration(bestConfig);
+    currentCriteria = problem.evaluateConfiguration(currentConfig);
+    problem.readSearchState(in);
+    deadlinePassed = false;
+    targetReached =
+        target && bestCriteria.isValid() && bestCriteria >= *target;
+  }
+
  private:
-  void swapCandidate(
-      const Configuration& candidate, const Criteria& candidateCriteria
-  ) {
+  enum class Outcome { rejected, accepted, bettered };
+
+  /**
+   * Cools down if the schedule policy says so
+   *
+   * @return true if the equilibrium ended
+   */
+  bool endEquilibriumIfOver() {
+    EquilibriumStats stats{
+        stepsInEquilibrium, acceptedInEquilibrium, stepsTotal
+    };
+    if (!policy.isEquilibriumOver(stats)) return false;
+    setTemperature(policy.nextTemperature(stats, temperature));
+    stepsInEquilibrium = 0;
+    acceptedInEquilibrium = 0;
+    if (deadline != Clock::time_point::max() && Clock::now() >= deadline)
+      deadlinePassed = true;
+    return true;
+  }
+
+  /** Steps which surely neither freeze the search nor end the equilibrium */
+  [[nodiscard]] uint32_t stepsBeforeCheck() const {
+    uint32_t steps = policy.stepsBeforeEquilibriumEnds(
+        {stepsInEquilibrium, acceptedInEquilibrium, stepsTotal}
+    );
+    steps = std::min(steps, schedule.stopAfterTotalSteps - stepsTotal);
+    steps = std::min(steps, schedule.stopAfterNoChange - stepsSinceChange);
+    steps = std::min(
+        steps, schedule.stopAfterNoBetterment - stepsSinceBetterment
+    );
+    return std::max(steps, 1u);
+  }
+
+  /**
+   * Does count steps, which need no checks but for reaching the target,
+   * with counters kept in locals
+   *
+   * @return count of steps done
+   */
+  uint32_t runBatch(uint32_t count) {
+    uint32_t done = 0;
+    uint32_t sinceChange = stepsSinceChange;
+    uint32_t sinceBetterment = stepsSinceBetterment;
+    uint32_t accepted = acceptedInEquilibrium;
+    while (done < count) {
+      done++;
+      sinceChange++;
+      sinceBetterment++;
+      Outcome outcome = tryCandidate();
+      if (outcome == Outcome::rejected) continue;
+      sinceChange = 0;
+      accepted++;
+      if (outcome == Outcome::bettered) {
+        sinceBetterment = 0;
+        if (targetReached) break;
+      }
+    }
+    stepsTotal += done;
+    stepsInEquilibrium += done;
+    stepsSinceChange = sinceChange;
+    stepsSinceBetterment = sinceBetterment;
+    acceptedInEquilibrium = accepted;
+    return done;
+  }
+
+  /** Proposes a candidate and moves to it if accepted */
+  Outcome tryCandidate() {
+    if constexpr (MoveProblemable<Problem, Configuration, Criteria>) {
+      auto move = problem.proposeMove(currentConfig, rng);
+      Criteria candidateCriteria = problem.evaluateMove(currentConfig, move);
+      if (!isAccepted(candidateCriteria)) return Outcome::rejected;
+      problem.applyMove(currentConfig, move);
+      if constexpr (journaled) journalMove(move);
+      return acceptCandidate(candidateCriteria);
+    } else {
+      Configuration candidate = problem.getRandomNeighbor(currentConfig, rng);
+      Criteria candidateCriteria = [&]() -> Criteria {
+        if constexpr (ProposedProblemable<Problem, Configuration, Criteria>)
+          return problem.evaluateProposed(candidate);
+        else
+          return problem.evaluateConfiguration(candidate);
+      }();
+      if (!isAccepted(candidateCriteria)) return Outcome::rejected;
+      currentConfig = std::move(candidate);
+      return acceptCandidate(candidateCriteria);
+    }
+  }
+
+  /** Keeps the journal of moves since the best configuration bounded */
+  template <typename Move>
+  void journalMove(const Move& move) {
+    journal.record(move);
+    if (journal.size() <= journal.limit) return;
+    materializeBest();
+    // Long since the best, the next one is cheaper to copy than to journal
+    if (journal.size() > journal.limit / 2) journal.stop();
+  }
+
+  void materializeBest() const {
+    if constexpr (journaled) {
+      journal.materialize([this](const typename Problem::Move& move) {
+        problem.replayMove(bestConfig, move);
+      });
+    }
+  }
+
+  /** Decides whether the search moves to candidate with given criteria */
+  bool isAccepted(const Criteria& candidateCriteria) {
+    double candidateWorse = candidateCriteria.howMuchWorseThan(currentCriteria);
+
+    DEBUG_PRINT("Candidate: " << candidateCriteria)
+    DEBUG_PRINT("Current: " << currentCriteria)
+    DEBUG_PRINT("CandidateWorse" << candidateWorse)
+
+    // If better
+    if (candidateWorse <= 0) return true;
+    // else: decide if we want to apply the less good candidate anyway
+
+    // Same as u < exp(-worse / T) for uniform u, without the exp
+    DEBUG_PRINT(
+        "Accept chance: " << std::exp(-candidateWorse * inverseTemperature)
+    )
+    return candidateWorse * inverseTemperature < rng.nextExponential();
+  }
+
+  /** Current configuration has already been replaced by the candidate */
+  Outcome acceptCandidate(const Criteria& candidateCriteria) {
     DEBUG_PRINT("Swapping")
-    currentConfig = candidate;
     currentCriteria = candidateCriteria;
-    stepsSinceChange = 0;
 
     double bestWorse = bestCriteria.howMuchWorseThan(currentCriteria);
-    if (bestWorse > 0 && currentCriteria.isValid()) {
-      bestConfig = candidate;
-      bestCriteria = candidateCriteria;
-      stepsSinceBetterment = 0;
+    if (bestWorse <= 0 || !currentCriteria.isValid()) return Outcome::accepted;
+    if constexpr (journaled) {
+      if (journal.isActive()) {
+        journal.markBest();
+      } else {
+        bestConfig = currentConfig;
+        journal.restart();
+      }
+    } else {
+      bestConfig = currentConfig;
     }
+    bestCriteria = currentCriteria;
+    if (target && bestCriteria >= *target) targetReached = true;
+    return Outcome::bettered;
   }
   ///@}
 
@@ -261,16 +657,21 @@ class Cooling {
   /// Return copies of values regarding current search state
   ///@{
   const Configuration& getCurrentConfiguration() const { return currentConfig; }
-  const Configuration& getBestConfiguration() const { return bestConfig; }
+  const Configuration& getBestConfiguration() const {
+    materializeBest();
+    return bestConfig;
+  }
   Configuration copyCurrentConfiguration() const {
     return Configuration(currentConfig);
   }
   Configuration copyBestConfiguration() const {
-    return Configuration(bestConfig);
+    return Configuration(getBestConfiguration());
   }
   const Criteria& getCurrentCriteria() const { return currentCriteria; }
   const Criteria& getBestCriteria() const { return bestCriteria; }
   Criteria copyCurrentCriteria() const { return Criteria(currentCriteria); }
   Criteria copyBestCriteria() const { return Criteria(bestCriteria); }
+  /** Stream continuing where the search stopped */
+  const Rng& getRng() const { return rng; }
   ///@}
 };
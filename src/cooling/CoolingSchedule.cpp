@@ -0,0 +1,129 @@
+#include "CoolingSchedule.h"
+
+#include <algorithm>
+#include <cmath>
+
+CoolingSchedule::CoolingSchedule(
+    uint32_t equilibrium,
+    double coolingFactor,
+    double startTemperature,
+    double stopTemperature,
+    uint32_t stopAfterTotalSteps,
+    uint32_t stopAfterNoChange,
+    uint32_t stopAfterNoBetterment
+)
+    : startTemperature(startTemperature),
+      coolingFactor(coolingFactor),
+      equilibrium(equilibrium),
+      stopTemperature(stopTemperature),
+      stopAfterTotalSteps(stopAfterTotalSteps),
+      stopAfterNoChange(stopAfterNoChange),
+      stopAfterNoBetterment(stopAfterNoBetterment) {}
+
+// ===================== Geometric =====================
+GeometricCooling::GeometricCooling(const CoolingSchedule& schedule)
+    : equilibrium(schedule.equilibrium),
+      coolingFactor(schedule.coolingFactor) {}
+
+bool GeometricCooling::isEquilibriumOver(const EquilibriumStats& stats) const {
+  return stats.steps >= equilibrium;
+}
+uint32_t GeometricCooling::stepsBeforeEquilibriumEnds(
+    const EquilibriumStats& stats
+) const {
+  return equilibrium - stats.steps;
+}
+double GeometricCooling::nextTemperature(
+    const EquilibriumStats& /*stats*/, double temperature
+) const {
+  return temperature * coolingFactor;
+}
+// ===================== EndGeometric =====================
+
+// ===================== LundyMees =====================
+LundyMeesCooling::LundyMeesCooling(const CoolingSchedule& schedule)
+    : equilibrium(schedule.equilibrium), beta(0) {
+  double start = schedule.startTemperature;
+  double stop = schedule.stopTemperature;
+  double factor = schedule.coolingFactor;
+  if (stop > 0 && stop < start && factor > 0 && factor < 1) {
+    // 1 / T grows by beta each equilibrium
+    double equilibria =
+        std::max(1.0, std::log(stop / start) / std::log(factor));
+    beta = (1 / stop - 1 / start) / equilibria;
+  }
+}
+
+bool LundyMeesCooling::isEquilibriumOver(const EquilibriumStats& stats) const {
+  return stats.steps >= equilibrium;
+}
+uint32_t LundyMeesCooling::stepsBeforeEquilibriumEnds(
+    const EquilibriumStats& stats
+) const {
+  return equilibrium - stats.steps;
+}
+double LundyMeesCooling::nextTemperature(
+    const EquilibriumStats& /*stats*/, double temperature
+) const {
+  return temperature / (1 + beta * temperature);
+}
+// ===================== EndLundyMees =====================
+
+// ===================== Lam =====================
+LamCooling::LamCooling(const CoolingSchedule& schedule)
+    : equilibrium(schedule.equilibrium),
+      coolingFactor(schedule.coolingFactor),
+      budget(schedule.stopAfterTotalSteps) {}
+
+double LamCooling::targetRate(double progress) {
+  if (progress < 0.15) return 0.44 + 0.56 * std::pow(560, -progress / 0.15);
+  if (progress < 0.65) return 0.44;
+  return 0.44 * std::pow(440, -(progress - 0.65) / 0.35);
+}
+
+bool LamCooling::isEquilibriumOver(const EquilibriumStats& stats) const {
+  return stats.steps >= equilibrium;
+}
+uint32_t LamCooling::stepsBeforeEquilibriumEnds(
+    const EquilibriumStats& stats
+) const {
+  return equilibrium - stats.steps;
+}
+double LamCooling::nextTemperature(
+    const EquilibriumStats& stats, double temperature
+) const {
+  double rate = stats.steps == 0
+      ? 0
+      : static_cast<double>(stats.accepted) / stats.steps;
+  return rate > targetRate(stats.stepsTotal / budget)
+      ? temperature * coolingFactor
+      : temperature / coolingFactor;
+}
+// ===================== EndLam =====================
+
+// ===================== AdaptiveEquilibrium =====================
+AdaptiveEquilibrium::AdaptiveEquilibrium(const CoolingSchedule& schedule)
+    : equilibrium(schedule.equilibrium),
+      enough(std::max(1u, schedule.equilibrium / 10)),
+      coolingFactor(schedule.coolingFactor) {}
+
+bool AdaptiveEquilibrium::isEquilibriumOver(
+    const EquilibriumStats& stats
+) const {
+  return stats.steps >= equilibrium || stats.accepted >= enough ||
+      (stats.accepted == 0 && stats.steps >= enough);
+}
+uint32_t AdaptiveEquilibrium::stepsBeforeEquilibriumEnds(
+    const EquilibriumStats& stats
+) const {
+  // Every acceptance takes a step
+  uint32_t steps = std::min(equilibrium - stats.steps, enough - stats.accepted);
+  if (stats.accepted == 0) steps = std::min(steps, enough - stats.steps);
+  return steps;
+}
+double AdaptiveEquilibrium::nextTemperature(
+    const EquilibriumStats& /*stats*/, double temperature
+) const {
+  return temperature * coolingFactor;
+}
+// ===================== EndAdaptiveEquilibrium =====================
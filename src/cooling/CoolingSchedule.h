@@ -0,0 +1,161 @@
+#pragma once
+
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+
+/** Data controlling the schedule of cooling and how long the search lasts */
+struct CoolingSchedule {
+  /// @name Temperature control
+  ///@{
+  double startTemperature;
+  double coolingFactor;
+  /** How many steps before cooling the temperature */
+  uint32_t equilibrium;
+  ///@}
+
+  /// @name Stop control
+  ///@{
+  double stopTemperature;
+  uint32_t stopAfterTotalSteps;
+  uint32_t stopAfterNoChange;
+  uint32_t stopAfterNoBetterment;
+  /** Wall-clock budget since the Cooling was created, checked once per
+   * equilibrium */
+  std::chrono::steady_clock::duration stopAfterTime =
+      std::chrono::steady_clock::duration::max();
+  ///@}
+
+  CoolingSchedule(
+      uint32_t equilibrium,
+      double coolingFactor,
+      double startTemperature,
+      double stopTemperature,
+      uint32_t stopAfterTotalSteps,
+      uint32_t stopAfterNoChange,
+      uint32_t stopAfterNoBetterment
+  );
+};
+
+/** What happened so far at the current temperature */
+struct EquilibriumStats {
+  uint32_t steps;
+  /** Candidates accepted among the steps */
+  uint32_t accepted;
+  /** Steps of the whole search */
+  uint32_t stepsTotal;
+};
+
+/**
+ * Decides when an equilibrium ends and which temperature follows, created
+ * by Cooling from its CoolingSchedule
+ *
+ * Decisions depend only on the schedule and the stats, which keeps
+ * checkpoints of Cooling free of the policy. stepsBeforeEquilibriumEnds()
+ * bounds how many more steps surely do not end the equilibrium, so Cooling
+ * can run them without asking.
+ */
+template <typename T>
+concept SchedulePolicy = std::constructible_from<T, const CoolingSchedule&> &&
+    requires(T policy, const EquilibriumStats& stats, double temperature) {
+      { policy.isEquilibriumOver(stats) } -> std::convertible_to<bool>;
+      {
+        policy.nextTemperature(stats, temperature)
+      } -> std::convertible_to<double>;
+      {
+        policy.stepsBeforeEquilibriumEnds(stats)
+      } -> std::convertible_to<uint32_t>;
+    };
+
+/** Equilibrium of fixed length, temperature times coolingFactor after it */
+class GeometricCooling {
+ private:
+  uint32_t equilibrium;
+  double coolingFactor;
+
+ public:
+  explicit GeometricCooling(const CoolingSchedule& schedule);
+  [[nodiscard]] bool isEquilibriumOver(const EquilibriumStats& stats) const;
+  [[nodiscard]] uint32_t stepsBeforeEquilibriumEnds(
+      const EquilibriumStats& stats
+  ) const;
+  [[nodiscard]] double nextTemperature(
+      const EquilibriumStats& stats, double temperature
+  ) const;
+};
+
+/**
+ * Lundy-Mees T' = T / (1 + beta T) after each fixed length equilibrium
+ *
+ * Beta is chosen so that stopTemperature is reached after as many
+ * equilibria as geometric cooling would need, but the temperature falls
+ * quickly while hot and slowly while cold.
+ */
+class LundyMeesCooling {
+ private:
+  uint32_t equilibrium;
+  double beta;
+
+ public:
+  explicit LundyMeesCooling(const CoolingSchedule& schedule);
+  [[nodiscard]] bool isEquilibriumOver(const EquilibriumStats& stats) const;
+  [[nodiscard]] uint32_t stepsBeforeEquilibriumEnds(
+      const EquilibriumStats& stats
+  ) const;
+  [[nodiscard]] double nextTemperature(
+      const EquilibriumStats& stats, double temperature
+  ) const;
+};
+
+/**
+ * Modified Lam schedule, which steers the temperature so the acceptance
+ * rate follows a target profile over the step budget: from 1 down to 0.44
+ * in the first 15 %, 0.44 until 65 % and then down to nearly 0
+ *
+ * After each fixed length equilibrium the temperature is multiplied by
+ * coolingFactor if the rate was above target, divided by it otherwise.
+ * The budget is stopAfterTotalSteps, so it should be set.
+ */
+class LamCooling {
+ private:
+  uint32_t equilibrium;
+  double coolingFactor;
+  double budget;
+
+ public:
+  explicit LamCooling(const CoolingSchedule& schedule);
+  /** Acceptance rate aimed at after given share of the budget */
+  [[nodiscard]] static double targetRate(double progress);
+  [[nodiscard]] bool isEquilibriumOver(const EquilibriumStats& stats) const;
+  [[nodiscard]] uint32_t stepsBeforeEquilibriumEnds(
+      const EquilibriumStats& stats
+  ) const;
+  [[nodiscard]] double nextTemperature(
+      const EquilibriumStats& stats, double temperature
+  ) const;
+};
+
+/**
+ * Geometric cooling with equilibrium length driven by acceptance
+ *
+ * Equilibrium ends after a tenth of its steps got accepted, which hot
+ * temperatures reach quickly, or after a tenth of its steps without any
+ * acceptance, which is a temperature too cold to stay at. Otherwise it
+ * lasts the full equilibrium steps.
+ */
+class AdaptiveEquilibrium {
+ private:
+  uint32_t equilibrium;
+  uint32_t enough;
+  double coolingFactor;
+
+ public:
+  explicit AdaptiveEquilibrium(const CoolingSchedule& schedule);
+  [[nodiscard]] bool isEquilibriumOver(const EquilibriumStats& stats) const;
+  [[nodiscard]] uint32_t stepsBeforeEquilibriumEnds(
+      const EquilibriumStats& stats
+  ) const;
+  [[nodiscard]] double nextTemperature(
+      const EquilibriumStats& stats, double temperature
+  ) const;
+};
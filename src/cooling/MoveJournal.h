@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Moves applied to the current configuration since a snapshot of the best
+ * one, which lets Cooling record a new best in O(1) instead of copying the
+ * whole configuration
+ *
+ * While active, replaying all moves on the snapshot gives the current
+ * configuration and replaying the first bestLength() of them gives the
+ * best one. Inactive journal records nothing, the snapshot is then the best
+ * configuration itself.
+ */
+template <typename Move>
+class MoveJournal {
+ private:
+  std::vector<Move> moves;
+  size_t bestMoves = 0;
+  bool active = true;
+
+ public:
+  /** Moves kept before the best one is materialized */
+  static constexpr size_t limit = 4096;
+
+  [[nodiscard]] bool isActive() const { return active; }
+  [[nodiscard]] size_t size() const { return moves.size(); }
+  [[nodiscard]] size_t bestLength() const { return bestMoves; }
+
+  void record(const Move& move) {
+    if (active) moves.push_back(move);
+  }
+  /** Current configuration became the best one */
+  void markBest() { bestMoves = moves.size(); }
+
+  /**
+   * Replays moves leading to the best configuration and forgets them, so
+   * the snapshot they were replayed on becomes the best one
+   */
+  template <typename Replay>
+  void materialize(Replay replay) {
+    for (size_t i = 0; i < bestMoves; i++) replay(moves[i]);
+    moves.erase(moves.begin(), moves.begin() + bestMoves);
+    bestMoves = 0;
+  }
+
+  /** Snapshot was just taken of the current configuration */
+  void restart() {
+    moves.clear();
+    bestMoves = 0;
+    active = true;
+  }
+  /** Snapshot is the best configuration, which is no longer the current */
+  void stop() {
+    moves.clear();
+    bestMoves = 0;
+    active = false;
+  }
+};
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <barrier>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Cooling.h"
+#include "Rng.h"
+
+/**
+ * Replica exchange over Cooling chains held at a ladder of fixed
+ * temperatures
+ *
+ * Each round every replica does a number of steps at its temperature, then
+ * neighboring temperatures attempt a Metropolis swap. Replicas swap their
+ * temperatures rather than their configurations, which keeps the exchange
+ * O(1). Even pairs are attempted in even rounds and odd pairs in odd ones.
+ *
+ * Every replica draws from its own stream and swaps are decided on a single
+ * thread between rounds, so the outcome does not depend on the count of
+ * threads.
+ */
+template <Configurable Configuration, Criteriable Criteria, typename Problem>
+  requires Problemable<Problem, Configuration, Criteria>
+class ParallelTempering {
+ public:
+  using Replica = Cooling<Configuration, Criteria, Problem>;
+
+  /** Swaps between a pair of neighboring temperatures */
+  struct PairStats {
+    uint64_t attempted = 0;
+    uint64_t accepted = 0;
+    [[nodiscard]] double acceptanceRate() const {
+      return attempted == 0 ? 0 : static_cast<double>(accepted) / attempted;
+    }
+  };
+
+ private:
+  /** Ascending, index into it is called a slot */
+  std::vector<double> ladder;
+  std::vector<Replica> replicas;
+  /** Index of replica currently at each slot */
+  std::vector<uint32_t> replicaAt;
+  /** Pair k is made of slots k and k + 1 */
+  std::vector<PairStats> pairs;
+  Rng rng;
+  uint32_t rounds = 0;
+  uint32_t bestReplica = 0;
+
+  // Stop conditions checked between rounds
+  std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::time_point::max();
+  std::optional<Criteria> target;
+  bool deadlinePassed = false;
+  bool targetReached = false;
+
+  static CoolingSchedule fixedSchedule(double temperature) {
+    // Never cools and never freezes, the engine decides when to stop
+    return CoolingSchedule(
+        UINT32_MAX, 1, temperature, 0, UINT32_MAX, UINT32_MAX, UINT32_MAX
+    );
+  }
+
+  void swapNeighbors() {
+    for (uint32_t k = rounds % 2; k + 1 < ladder.size(); k += 2) {
+      Replica& cold = replicas[replicaAt[k]];
+      Replica& hot = replicas[replicaAt[k + 1]];
+      double coldWorse =
+          cold.getCurrentCriteria().howMuchWorseThan(hot.getCurrentCriteria());
+      // Hand the better configuration to the colder temperature for sure,
+      // otherwise with the Metropolis probability
+      double exponent = coldWorse * (1 / ladder[k] - 1 / ladder[k + 1]);
+      pairs[k].attempted++;
+      if (exponent >= 0 || rng.nextDouble() < std::exp(exponent)) {
+        pairs[k].accepted++;
+        std::swap(replicaAt[k], replicaAt[k + 1]);
+        cold.setTemperature(ladder[k + 1]);
+        hot.setTemperature(ladder[k]);
+      }
+    }
+    for (uint32_t i = 0; i < replicas.size(); i++) {
+      if (replicas[bestReplica].getBestCriteria() <
+          replicas[i].getBestCriteria())
+        bestReplica = i;
+    }
+    rounds++;
+
+    const Criteria& best = replicas[bestReplica].getBestCriteria();
+    if (target && best.isValid() && best >= *target) targetReached = true;
+    if (deadline != std::chrono::steady_clock::time_point::max() &&
+        std::chrono::steady_clock::now() >= deadline)
+      deadlinePassed = true;
+  }
+
+ public:
+  /**
+   * Replicas start from random configurations, replica i draws from the
+   * stream jumped i + 1 times, swaps from the given one
+   *
+   * @param ladder ascending temperatures, one replica for each
+   */
+  ParallelTempering(const Problem& problem, std::vector<double> ladder, Rng rng)
+      : ladder(std::move(ladder)), rng(rng) {
+    Rng stream = rng;
+    replicas.reserve(this->ladder.size());
+    for (uint32_t i = 0; i < this->ladder.size(); i++) {
+      stream.jump();
+      replicas.emplace_back(problem, fixedSchedule(this->ladder[i]), stream);
+      replicaAt.push_back(i);
+    }
+    pairs.resize(this->ladder.empty() ? 0 : this->ladder.size() - 1);
+  }
+
+  /** Count temperatures from cold to hot with a constant ratio */
+  static std::vector<double> geometricLadder(
+      double cold, double hot, uint32_t count
+  ) {
+    std::vector<double> ladder;
+    for (uint32_t k = 0; k < count; k++) {
+      double exponent = count == 1 ? 0 : static_cast<double>(k) / (count - 1);
+      ladder.push_back(cold * std::pow(hot / cold, exponent));
+    }
+    return ladder;
+  }
+
+  /** Stops run() after the round during which deadline passed */
+  void setDeadline(std::chrono::steady_clock::time_point deadline) {
+    this->deadline = deadline;
+  }
+  /**
+   * Stops run() after the round in which a valid configuration at least as
+   * good as target was found
+   */
+  void setTarget(const Criteria& target) { this->target = target; }
+
+  /** Runs given count of rounds, replicas split among threads */
+  void run(uint32_t roundCount, uint32_t stepsPerRound, uint32_t threads) {
+    if (threads == 0 || threads > replicas.size()) threads = replicas.size();
+    std::barrier sync(threads, [this]() noexcept { swapNeighbors(); });
+    std::vector<std::jthread> workers;
+    workers.reserve(threads);
+    for (uint32_t w = 0; w < threads; w++) {
+      workers.emplace_back([&, w] {
+        for (uint32_t round = 0; round < roundCount; round++) {
+          for (uint32_t i = w; i < replicas.size(); i += threads) {
+            replicas[i].runSteps(stepsPerRound);
+          }
+          sync.arrive_and_wait();
+          // Written by the completion, which happens before the wait returns
+          if (targetReached || deadlinePassed) break;
+        }
+      });
+    }
+  }
+
+  [[nodiscard]] uint32_t size() const { return replicas.size(); }
+  [[nodiscard]] uint32_t getRounds() const { return rounds; }
+  /** Replicas never freeze, so one of: target|time|max */
+  [[nodiscard]] std::string endedBecause() const {
+    if (targetReached) return "target";
+    if (deadlinePassed) return "time";
+    return "max";
+  }
+  [[nodiscard]] double temperature(uint32_t slot) const { return ladder[slot]; }
+  /** Replica currently at given slot */
+  [[nodiscard]] const Replica& replica(uint32_t slot) const {
+    return replicas[replicaAt[slot]];
+  }
+  /** Stats of swaps between slots pair and pair + 1 */
+  [[nodiscard]] const PairStats& pairStats(uint32_t pair) const {
+    return pairs[pair];
+  }
+  /** Replica which found the best configuration, as of the last round */
+  [[nodiscard]] const Replica& best() const { return replicas[bestReplica]; }
+};
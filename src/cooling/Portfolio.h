@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "Cooling.h"
+#include "Rng.h"
+
+/**
+ * Runs independent Cooling chains in parallel, each on its own thread
+ *
+ * Chain i draws random numbers from the given stream jumped i times, so
+ * the outcome depends only on the seed and the count of chains, never on
+ * how the threads get scheduled.
+ */
+template <
+    Configurable Configuration,
+    Criteriable Criteria,
+    typename Problem,
+    SchedulePolicy Schedule = GeometricCooling>
+  requires Problemable<Problem, Configuration, Criteria>
+class Portfolio {
+ public:
+  using Chain = Cooling<Configuration, Criteria, Problem, Schedule>;
+
+ private:
+  std::vector<std::optional<Chain>> chains;
+
+ public:
+  explicit Portfolio(uint32_t count) : chains(count) {}
+
+  /**
+   * Runs all chains to completion
+   *
+   * An exception thrown on a chain's thread ends that chain only, once all
+   * threads are joined the one of the lowest chain index is rethrown.
+   *
+   * @param makeChain creates chain of given index on its thread from the
+   *        chain's stream
+   * @param runChain drives chain of given index until its search is over
+   */
+  void run(
+      Rng rng,
+      const std::function<Chain(uint32_t, Rng)>& makeChain,
+      const std::function<void(Chain&, uint32_t)>& runChain
+  ) {
+    std::vector<Rng> streams;
+    streams.reserve(chains.size());
+    for (uint32_t i = 0; i < chains.size(); i++) {
+      streams.push_back(rng);
+      rng.jump();
+    }
+
+    std::vector<std::exception_ptr> errors(chains.size());
+    {
+      std::vector<std::jthread> workers;
+      workers.reserve(chains.size());
+      for (uint32_t i = 0; i < chains.size(); i++) {
+        workers.emplace_back([&, i] {
+          // Escaping its thread, the exception would terminate the process
+          try {
+            chains[i].emplace(makeChain(i, streams[i]));
+            runChain(*chains[i], i);
+          } catch (...) {
+            errors[i] = std::current_exception();
+          }
+        });
+      }
+    }
+    for (const std::exception_ptr& error : errors) {
+      if (error) std::rethrow_exception(error);
+    }
+  }
+
+  [[nodiscard]] uint32_t size() const { return chains.size(); }
+  /** Only valid after run() */
+  [[nodiscard]] const Chain& chain(uint32_t index) const {
+    return *chains[index];
+  }
+  /** Index of chain with the best criteria, the lowest one on ties */
+  [[nodiscard]] uint32_t bestIndex() const {
+    uint32_t best = 0;
+    for (uint32_t i = 1; i < chains.size(); i++) {
+      if (chains[best]->getBestCriteria() < chains[i]->getBestCriteria())
+        best = i;
+    }
+    return best;
+  }
+};
@@ -0,0 +1,438 @@
+#include "compressedInput.h"
+
+#include <fcntl.h>
+#include <fmt/core.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifdef DIMACS_PARSING_GZIP
+#include <zlib.h>
+#endif
+#ifdef DIMACS_PARSING_XZ
+#include <lzma.h>
+#endif
+#ifdef DIMACS_PARSING_ZSTD
+#include <zstd.h>
+#endif
+
+Compression compressionOf(std::string_view start) {
+  if (start.starts_with("\x1f\x8b")) return Compression::gzip;
+  if (start.starts_with(std::string_view("\xfd" "7zXZ\0", 6)))
+    return Compression::xz;
+  if (start.starts_with("\x28\xb5\x2f\xfd")) return Compression::zstd;
+  return Compression::none;
+}
+
+bool isSupported(Compression compression) {
+  switch (compression) {
+    case Compression::none:
+      return true;
+    case Compression::gzip:
+#ifdef DIMACS_PARSING_GZIP
+      return true;
+#else
+      return false;
+#endif
+    case Compression::xz:
+#ifdef DIMACS_PARSING_XZ
+      return true;
+#else
+      return false;
+#endif
+    case Compression::zstd:
+#ifdef DIMACS_PARSING_ZSTD
+      return true;
+#else
+      return false;
+#endif
+  }
+  return false;
+}
+
+namespace {
+
+constexpr size_t chunkSize = 1 << 20;
+
+const char* nameOf(Compression compression) {
+  switch (compression) {
+    case Compression::gzip:
+      return "gzip";
+    case Compression::xz:
+      return "xz";
+    case Compression::zstd:
+      return "zstd";
+    default:
+      return "uncompressed";
+  }
+}
+
+/** Reads a file descriptor, serving the bytes peeked at first */
+class RawInput {
+ private:
+  int fd;
+  bool owned;
+  std::string peeked;
+  size_t peekedServed = 0;
+
+ public:
+  RawInput(int fd, bool owned) : fd(fd), owned(owned) {}
+  RawInput(const RawInput&) = delete;
+  RawInput& operator=(const RawInput&) = delete;
+  ~RawInput() {
+    if (owned) close(fd);
+  }
+
+  /** First count bytes or fewer at the end of input, served again by reads */
+  std::string_view peek(size_t count) {
+    std::string start(count, '\0');
+    size_t got = 0;
+    while (got < count) {
+      size_t n = readSome(start.data() + got, count - got);
+      if (n == 0) break;
+      got += n;
+    }
+    start.resize(got);
+    peeked = std::move(start);
+    peekedServed = 0;
+    return peeked;
+  }
+
+  /** Returns 0 only at the end of input */
+  size_t readSome(char* out, size_t capacity) {
+    if (peekedServed < peeked.size()) {
+      size_t n = std::min(capacity, peeked.size() - peekedServed);
+      std::copy_n(peeked.data() + peekedServed, n, out);
+      peekedServed += n;
+      return n;
+    }
+    for (;;) {
+      ssize_t n = read(fd, out, capacity);
+      if (n >= 0) return static_cast<size_t>(n);
+      if (errno != EINTR)
+        throw std::system_error(errno, std::generic_category(), "Cannot read");
+    }
+  }
+};
+
+/** Thrown through the decoder when the reader is gone */
+struct Stopped {};
+
+}  // namespace
+
+/**
+ * Hands chunks decompressed by its thread over to the stream, at most a few
+ * of them wait at once
+ */
+class DecompressingInput::Buffer : public std::streambuf {
+ private:
+  static constexpr size_t waitingLimit = 4;
+
+  Compression compression_;
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<std::string> waiting;
+  /** Read chunks, reused for decompressing into */
+  std::vector<std::string> spare;
+  bool ended = false;
+  bool stopping = false;
+  std::exception_ptr failure;
+  /** Chunk the get area is in */
+  std::string current;
+  /** Declared last, it uses everything above */
+  std::jthread worker;
+
+  /** Chunk to decompress into, empty, but with capacity of chunkSize */
+  std::string takeSpare() {
+    std::lock_guard lock(mutex);
+    if (spare.empty()) return {};
+    std::string chunk = std::move(spare.back());
+    spare.pop_back();
+    return chunk;
+  }
+
+  /** Chunk being filled by the decoder */
+  class Sink {
+   private:
+    Buffer& buffer;
+    std::string chunk;
+    size_t size = 0;
+
+   public:
+    explicit Sink(Buffer& buffer) : buffer(buffer) { renew(); }
+    void renew() {
+      chunk = buffer.takeSpare();
+      chunk.resize(chunkSize);
+      size = 0;
+    }
+    /** Room left in the chunk, never empty */
+    std::span<char> space() { return {chunk.data() + size, chunkSize - size}; }
+    void filled(size_t count) {
+      size += count;
+      if (size == chunkSize) flush();
+    }
+    void flush() {
+      if (size == 0) return;
+      chunk.resize(size);
+      buffer.push(std::move(chunk));
+      renew();
+    }
+  };
+
+  void push(std::string chunk) {
+    std::unique_lock lock(mutex);
+    changed.wait(lock, [this] {
+      return waiting.size() < waitingLimit || stopping;
+    });
+    if (stopping) throw Stopped();
+    waiting.push_back(std::move(chunk));
+    changed.notify_all();
+  }
+
+  void produce(RawInput& raw) {
+    Sink sink(*this);
+    switch (compression_) {
+      case Compression::none:
+        copy(raw, sink);
+        break;
+      case Compression::gzip:
+        inflateGzip(raw, sink);
+        break;
+      case Compression::xz:
+        decodeXz(raw, sink);
+        break;
+      case Compression::zstd:
+        decompressZstd(raw, sink);
+        break;
+    }
+    sink.flush();
+  }
+
+  static void copy(RawInput& raw, Sink& sink) {
+    for (;;) {
+      std::span<char> space = sink.space();
+      size_t n = raw.readSome(space.data(), space.size());
+      if (n == 0) return;
+      sink.filled(n);
+    }
+  }
+
+  static void inflateGzip(RawInput& raw, Sink& sink) {
+#ifdef DIMACS_PARSING_GZIP
+    z_stream z{};
+    // Window of 15 bits, plus 32 to detect the gzip header
+    if (inflateInit2(&z, 15 + 32) != Z_OK)
+      throw std::runtime_error("Cannot start gzip decompression");
+    std::unique_ptr<z_stream, int (*)(z_stream*)> end(&z, inflateEnd);
+    std::vector<char> in(chunkSize);
+    bool inputEnded = false;
+    auto refill = [&] {
+      size_t n = raw.readSome(in.data(), in.size());
+      inputEnded = n == 0;
+      z.next_in = reinterpret_cast<Bytef*>(in.data());
+      z.avail_in = static_cast<uInt>(n);
+    };
+    for (;;) {
+      if (z.avail_in == 0 && !inputEnded) refill();
+      std::span<char> space = sink.space();
+      z.next_out = reinterpret_cast<Bytef*>(space.data());
+      z.avail_out = static_cast<uInt>(space.size());
+      int result = inflate(&z, Z_NO_FLUSH);
+      sink.filled(space.size() - z.avail_out);
+      if (result == Z_STREAM_END) {
+        // Members of a gzip file can follow one another
+        if (z.avail_in == 0) refill();
+        if (inputEnded) return;
+        inflateReset(&z);
+      } else if (result == Z_BUF_ERROR && inputEnded) {
+        throw std::invalid_argument("Compressed input ended unexpectedly");
+      } else if (result != Z_OK && result != Z_BUF_ERROR) {
+        throw std::invalid_argument(
+            fmt::format(
+                "Cannot decompress gzip input: {}",
+                z.msg ? z.msg : "unknown error"
+            )
+        );
+      }
+    }
+#else
+    (void)raw;
+    (void)sink;
+#endif
+  }
+
+  static void decodeXz(RawInput& raw, Sink& sink) {
+#ifdef DIMACS_PARSING_XZ
+    lzma_stream stream = LZMA_STREAM_INIT;
+    if (lzma_stream_decoder(&stream, UINT64_MAX, LZMA_CONCATENATED) !=
+        LZMA_OK)
+      throw std::runtime_error("Cannot start xz decompression");
+    std::unique_ptr<lzma_stream, void (*)(lzma_stream*)> end(
+        &stream, lzma_end
+    );
+    std::vector<char> in(chunkSize);
+    lzma_action action = LZMA_RUN;
+    for (;;) {
+      if (stream.avail_in == 0 && action == LZMA_RUN) {
+        size_t n = raw.readSome(in.data(), in.size());
+        if (n == 0) action = LZMA_FINISH;
+        stream.next_in = reinterpret_cast<const uint8_t*>(in.data());
+        stream.avail_in = n;
+      }
+      std::span<char> space = sink.space();
+      stream.next_out = reinterpret_cast<uint8_t*>(space.data());
+      stream.avail_out = space.size();
+      lzma_ret result = lzma_code(&stream, action);
+      sink.filled(space.size() - stream.avail_out);
+      if (result == LZMA_STREAM_END) return;
+      if (result == LZMA_BUF_ERROR && action == LZMA_FINISH)
+        throw std::invalid_argument("Compressed input ended unexpectedly");
+      if (result != LZMA_OK && result != LZMA_BUF_ERROR) {
+        throw std::invalid_argument(
+            fmt::format("Cannot decompress xz input, error {}", +result)
+        );
+      }
+    }
+#else
+    (void)raw;
+    (void)sink;
+#endif
+  }
+
+  static void decompressZstd(RawInput& raw, Sink& sink) {
+#ifdef DIMACS_PARSING_ZSTD
+    std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> context(
+        ZSTD_createDCtx(), ZSTD_freeDCtx
+    );
+    if (!context) throw std::runtime_error("Cannot start zstd decompression");
+    std::vector<char> in(chunkSize);
+    /** 0 once a frame is complete */
+    size_t lastResult = 0;
+    for (;;) {
+      size_t n = raw.readSome(in.data(), in.size());
+      ZSTD_inBuffer input{in.data(), n, 0};
+      // Output filled up may hold back more, even once input is consumed
+      bool outputFull = true;
+      while (input.pos < input.size || outputFull) {
+        std::span<char> space = sink.space();
+        ZSTD_outBuffer output{space.data(), space.size(), 0};
+        size_t consumed = input.pos;
+        size_t result = ZSTD_decompressStream(context.get(), &output, &input);
+        if (ZSTD_isError(result)) {
+          throw std::invalid_argument(
+              fmt::format(
+                  "Cannot decompress zstd input: {}", ZSTD_getErrorName(result)
+              )
+          );
+        }
+        // Otherwise the result is a hint for a frame which may never come
+        if (input.pos > consumed || output.pos > 0) lastResult = result;
+        outputFull = output.pos == output.size;
+        sink.filled(output.pos);
+      }
+      if (n == 0) break;
+    }
+    if (lastResult != 0)
+      throw std::invalid_argument("Compressed input ended unexpectedly");
+#else
+    (void)raw;
+    (void)sink;
+#endif
+  }
+
+ protected:
+  int_type underflow() override {
+    std::unique_lock lock(mutex);
+    if (current.capacity() >= chunkSize) {
+      current.clear();
+      spare.push_back(std::move(current));
+    }
+    changed.wait(lock, [this] { return !waiting.empty() || ended; });
+    if (waiting.empty()) {
+      setg(nullptr, nullptr, nullptr);
+      if (failure) std::rethrow_exception(failure);
+      return traits_type::eof();
+    }
+    current = std::move(waiting.front());
+    waiting.pop_front();
+    changed.notify_all();
+    setg(current.data(), current.data(), current.data() + current.size());
+    return traits_type::to_int_type(current.front());
+  }
+
+ public:
+  Buffer(std::unique_ptr<RawInput> raw, Compression compression)
+      : compression_(compression),
+        worker([this, raw = std::move(raw)] {
+          try {
+            produce(*raw);
+          } catch (const Stopped&) {
+          } catch (...) {
+            std::lock_guard lock(mutex);
+            failure = std::current_exception();
+          }
+          std::lock_guard lock(mutex);
+          ended = true;
+          changed.notify_all();
+        }) {}
+
+  ~Buffer() override {
+    {
+      std::lock_guard lock(mutex);
+      stopping = true;
+      changed.notify_all();
+    }
+    worker.join();
+  }
+
+  [[nodiscard]] Compression compression() const { return compression_; }
+};
+
+DecompressingInput::DecompressingInput(const std::filesystem::path& path)
+    : input(nullptr) {
+  std::unique_ptr<RawInput> raw;
+  if (path == "-") {
+    raw = std::make_unique<RawInput>(STDIN_FILENO, false);
+  } else {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(
+          errno, std::generic_category(), "Cannot open " + path.string()
+      );
+    }
+    raw = std::make_unique<RawInput>(fd, true);
+  }
+  // Longest magic is that of xz
+  Compression compression = compressionOf(raw->peek(6));
+  if (!isSupported(compression)) {
+    throw std::invalid_argument(
+        fmt::format(
+            "Input is {} compressed, which this build cannot read",
+            nameOf(compression)
+        )
+    );
+  }
+  buffer = std::make_unique<Buffer>(std::move(raw), compression);
+  input.rdbuf(buffer.get());
+  // Rethrows failures of the thread instead of only setting badbit
+  input.exceptions(std::ios::badbit);
+}
+
+DecompressingInput::~DecompressingInput() = default;
+
+std::istream& DecompressingInput::stream() { return input; }
+Compression DecompressingInput::compression() const {
+  return buffer->compression();
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <string_view>
+
+/** Formats of input, told apart by their first bytes */
+enum class Compression { none, gzip, xz, zstd };
+
+/** Format the data starting with given bytes is in */
+Compression compressionOf(std::string_view start);
+/** Whether the library for the format was found when building */
+bool isSupported(Compression compression);
+
+/**
+ * Stream of a file, or of stdin for path "-", decompressed on a thread of
+ * its own, so decompression overlaps with parsing what it produced
+ *
+ * Uncompressed input passes through the same way. Errors of reading or
+ * decompressing are rethrown by reads of stream() once the data before them
+ * got read.
+ */
+class DecompressingInput {
+ private:
+  class Buffer;
+  std::unique_ptr<Buffer> buffer;
+  std::istream input;
+
+ public:
+  /**
+   * Throws std::system_error if the file cannot be opened and
+   * std::invalid_argument if its format is not supported
+   */
+  explicit DecompressingInput(const std::filesystem::path& path);
+  DecompressingInput(const DecompressingInput&) = delete;
+  DecompressingInput& operator=(const DecompressingInput&) = delete;
+  /** Stops the thread, without waiting for the rest of the input */
+  ~DecompressingInput();
+
+  [[nodiscard]] std::istream& stream();
+  [[nodiscard]] Compression compression() const;
+};
@@ -1,82 +1,101 @@
 #include "dimacsParsing.h"
 
-#include <fmt/core.h>
-#include <fmt/ranges.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-#include <algorithm>
-#include <iostream>
-#include <ranges>
-#include <sstream>
+#include <cerrno>
+#include <charconv>
+#include <system_error>
 
-std::vector<std::string> toWords(std::string const& string) {
-  std::vector<std::string> words;
-  std::istringstream iss(string);
-  std::string word;
+int32_t parseDimacsNumber(std::string_view word) {
+  const char* begin = word.data();
+  const char* end = word.data() + word.size();
+  if (begin != end && *begin == '+') begin++;
+  int32_t number = 0;
+  auto [stopped, error] = std::from_chars(begin, end, number);
+  if (error == std::errc::result_out_of_range)
+    throw std::out_of_range(fmt::format("Number {} is out of range", word));
+  if (error != std::errc() || stopped != end)
+    throw std::invalid_argument(
+        fmt::format("Expected number, but got {}", word)
+    );
+  return number;
+}
 
-  while (std::getline(iss, word, ' ')) words.push_back(word);
-  // Filter empty words and convert to vector
-  auto res = words |
-      std::views::filter([](const std::string& w) { return !w.empty(); });
-  return std::vector<std::string>(res.begin(), res.end());
+int32_t parseDimacsNumber(std::optional<std::string_view> word) {
+  if (!word) throw std::invalid_argument("Expected number, but line ended");
+  return parseDimacsNumber(*word);
 }
 
-// Inspiration here:
-// https://courses.fit.cvut.cz/NI-KOP/tutorials/files/sat-brute-force.html
-ParsedDimacsFile parseDimacsFile(std::istream& input) {
-  uint32_t varCount = UINT32_MAX;
-  uint32_t clauseCount = UINT32_MAX;
-  std::vector<int32_t> weights;
-  std::vector<std::vector<int32_t>> clauses;
+// ===================== MappedFile =====================
+MappedFile::MappedFile(const std::filesystem::path& path) : data(MAP_FAILED) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::system_error(
+        errno, std::generic_category(), "Cannot open " + path.string()
+    );
+  }
+  struct stat status {};
+  if (fstat(fd, &status) == 0 && S_ISREG(status.st_mode) &&
+      status.st_size > 0) {
+    length = static_cast<size_t>(status.st_size);
+    data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) madvise(data, length, MADV_SEQUENTIAL);
+  }
+  close(fd);
+}
+MappedFile::~MappedFile() {
+  if (isMapped()) munmap(data, length);
+}
+bool MappedFile::isMapped() const { return data != MAP_FAILED; }
+std::string_view MappedFile::text() const {
+  return {static_cast<const char*>(data), length};
+}
+// ===================== EndMappedFile =====================
 
-  for (std::string line; std::getline(input, line);) {
-    std::vector<std::string> words = toWords(line);
+namespace {
 
-    if (line.empty() || words[0] == "c") continue;  // Comment
-    if (words[0] == "p") {  // Parsing format and var/clause counts
-      if (words[1] != "mwcnf") {
-        throw std::invalid_argument("Given format is not mwcnf");
-      }
-      varCount = std::stoi(words[2]);
-      clauseCount = std::stoi(words[3]);
-    } else if (words[0] == "w") {  // Parsing weights
-      if (words.size() - 2 != varCount) {
-        throw std::invalid_argument(
-            fmt::format(
-                "Expected {} weights, but got {}", varCount, words.size() - 2
-            )
-        );
-      }
-      if (*(words.end() - 1) != "0")
-        throw std::invalid_argument("Weights not ended by 0");
+/** Keeps every clause in a vector of its own */
+struct Collector {
+  uint32_t varCount = UINT32_MAX;
+  std::vector<std::vector<int32_t>> collectedClauses;
+  std::vector<int32_t> collectedWeights;
 
-      weights.resize(words.size() - 2);
-      std::transform(
-          words.begin() + 1,
-          words.end() - 1,
-          weights.begin(),
-          [](std::string const& s) { return std::stoi(s); }
-      );
-    } else {  // Line with clause
-      std::vector<int32_t> clause(words.size());
-      std::transform(
-          words.begin(),
-          words.end(),
-          clause.begin(),
-          [](std::string const& word) { return std::stoi(word); }
-      );
-      clause.pop_back();
-      clauses.push_back(clause);
-    }
+  void problem(uint32_t variables, uint32_t /*clauseCount*/) {
+    varCount = variables;
+  }
+  void weights(std::span<const int32_t> parsed) {
+    collectedWeights.assign(parsed.begin(), parsed.end());
+  }
+  void clause(std::span<const int32_t> literals) {
+    collectedClauses.emplace_back(literals.begin(), literals.end());
   }
 
-  if (clauseCount != clauses.size())
-    throw std::invalid_argument(
-        fmt::format(
-            "Expected {} clauses, but got {}", clauseCount, clauses.size()
-        )
-    );
-  if (weights.empty()) throw std::invalid_argument("Expected any weights");
-  if (clauses.empty()) throw std::invalid_argument("Expected any clauses");
+  ParsedDimacsFile collected() && {
+    return {
+        varCount, std::move(collectedClauses), std::move(collectedWeights)
+    };
+  }
+};
+
+}  // namespace
+
+ParsedDimacsFile parseDimacsText(std::string_view text) {
+  Collector collector;
+  parseDimacsText(text, collector);
+  return std::move(collector).collected();
+}
+
+ParsedDimacsFile parseDimacsFile(std::istream& input) {
+  Collector collector;
+  parseDimacsFile(input, collector);
+  return std::move(collector).collected();
+}
 
-  return {varCount, clauses, weights};
+ParsedDimacsFile parseDimacsFile(const std::filesystem::path& path) {
+  Collector collector;
+  parseDimacsFile(path, collector);
+  return std::move(collector).collected();
 }
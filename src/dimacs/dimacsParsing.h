@@ -1,7 +1,18 @@
 #pragma once
+#include <fmt/core.h>
+
+#include <cstdint>
+#include <filesystem>
 #include <istream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "compressedInput.h"
+
 struct ParsedDimacsFile {
   ParsedDimacsFile(
       const uint32_t var_count,
@@ -14,4 +25,213 @@ struct ParsedDimacsFile {
   std::vector<int32_t> weights;
 };
 
+/**
+ * Receives the instance piece by piece as it is scanned, so it can be
+ * stored in its final layout right away
+ *
+ * Spans passed in are only valid during the call. Weights are received
+ * again for every weights line, the last ones hold.
+ */
+template <typename T>
+concept DimacsConsumer = requires(
+    T consumer, uint32_t count, std::span<const int32_t> numbers
+) {
+  consumer.problem(count, count);
+  consumer.weights(numbers);
+  consumer.clause(numbers);
+};
+
+/** Words of a line separated by spaces, tabs or carriage returns */
+class DimacsWords {
+ private:
+  std::string_view rest;
+
+  static bool isSeparator(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+ public:
+  explicit DimacsWords(std::string_view line) : rest(line) {}
+
+  std::optional<std::string_view> next() {
+    size_t begin = 0;
+    while (begin < rest.size() && isSeparator(rest[begin])) begin++;
+    if (begin == rest.size()) return std::nullopt;
+    size_t end = begin;
+    while (end < rest.size() && !isSeparator(rest[end])) end++;
+    std::string_view word = rest.substr(begin, end - begin);
+    rest.remove_prefix(end);
+    return word;
+  }
+};
+
+/**
+ * Like std::stoi, but the whole word must be the number, throws
+ * std::invalid_argument otherwise and std::out_of_range on overflow
+ */
+int32_t parseDimacsNumber(std::string_view word);
+int32_t parseDimacsNumber(std::optional<std::string_view> word);
+
+/**
+ * Scans numbers straight from lines of text into the consumer, without
+ * allocating per token
+ *
+ * Throws std::invalid_argument on malformed input.
+ */
+// Inspiration here:
+// https://courses.fit.cvut.cz/NI-KOP/tutorials/files/sat-brute-force.html
+template <DimacsConsumer Consumer>
+class DimacsParser {
+ private:
+  Consumer& consumer;
+  uint32_t varCount = UINT32_MAX;
+  uint32_t clauseCount = UINT32_MAX;
+  uint32_t clausesParsed = 0;
+  bool anyWeights = false;
+  /** Numbers of the line being parsed, reused across lines */
+  std::vector<int32_t> numbers;
+
+  void parseWeights(DimacsWords words) {
+    numbers.clear();
+    std::string_view last;
+    size_t count = 0;
+    while (std::optional<std::string_view> word = words.next()) {
+      if (count > 0) numbers.push_back(parseDimacsNumber(last));
+      last = *word;
+      count++;
+    }
+    // Last word is the terminating 0
+    if (count == 0 || count - 1 != varCount) {
+      throw std::invalid_argument(
+          fmt::format(
+              "Expected {} weights, but got {}",
+              varCount,
+              static_cast<int64_t>(count) - 1
+          )
+      );
+    }
+    if (last != "0") throw std::invalid_argument("Weights not ended by 0");
+    anyWeights = !numbers.empty();
+    consumer.weights(numbers);
+  }
+
+ public:
+  explicit DimacsParser(Consumer& consumer) : consumer(consumer) {}
+
+  void parseLine(std::string_view line) {
+    DimacsWords words(line);
+    std::optional<std::string_view> first = words.next();
+    if (!first || *first == "c") return;  // Empty or comment
+    if (*first == "p") {  // Parsing format and var/clause counts
+      if (words.next() != "mwcnf") {
+        throw std::invalid_argument("Given format is not mwcnf");
+      }
+      varCount = parseDimacsNumber(words.next());
+      clauseCount = parseDimacsNumber(words.next());
+      consumer.problem(varCount, clauseCount);
+    } else if (*first == "w") {  // Parsing weights
+      parseWeights(words);
+    } else {  // Line with clause, the terminating 0 dropped
+      numbers.clear();
+      numbers.push_back(parseDimacsNumber(*first));
+      while (std::optional<std::string_view> word = words.next())
+        numbers.push_back(parseDimacsNumber(*word));
+      numbers.pop_back();
+      consumer.clause(numbers);
+      clausesParsed++;
+    }
+  }
+
+  /** Parses complete lines of text, returns length of the ones parsed */
+  size_t parseLines(std::string_view text) {
+    size_t parsed = 0;
+    for (size_t end; (end = text.find('\n', parsed)) != text.npos;) {
+      parseLine(text.substr(parsed, end - parsed));
+      parsed = end + 1;
+    }
+    return parsed;
+  }
+
+  /** Validates the counts once all lines are parsed */
+  void finish() const {
+    if (clauseCount != clausesParsed)
+      throw std::invalid_argument(
+          fmt::format(
+              "Expected {} clauses, but got {}", clauseCount, clausesParsed
+          )
+      );
+    if (!anyWeights) throw std::invalid_argument("Expected any weights");
+    if (clausesParsed == 0)
+      throw std::invalid_argument("Expected any clauses");
+  }
+};
+
+/** Read only private mapping of a whole file, unmapped on destruction */
+class MappedFile {
+ private:
+  void* data;
+  size_t length = 0;
+
+ public:
+  /**
+   * Maps nothing if the file is not regular or is empty, throws
+   * std::system_error if it cannot be opened
+   */
+  explicit MappedFile(const std::filesystem::path& path);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  [[nodiscard]] bool isMapped() const;
+  [[nodiscard]] std::string_view text() const;
+};
+
+/// @name Parsing into a consumer
+///@{
+template <DimacsConsumer Consumer>
+void parseDimacsText(std::string_view text, Consumer& consumer) {
+  DimacsParser<Consumer> parser(consumer);
+  size_t parsed = parser.parseLines(text);
+  parser.parseLine(text.substr(parsed));  // Last line may lack a newline
+  parser.finish();
+}
+
+/** Reads the stream in chunks, which suits pipes */
+template <DimacsConsumer Consumer>
+void parseDimacsFile(std::istream& input, Consumer& consumer) {
+  constexpr size_t chunkSize = 1 << 20;
+  DimacsParser<Consumer> parser(consumer);
+  // Holds the line a chunk ended in the middle of, followed by next chunk
+  std::string buffer;
+  while (input) {
+    size_t kept = buffer.size();
+    buffer.resize(kept + chunkSize);
+    input.read(buffer.data() + kept, chunkSize);
+    buffer.resize(kept + static_cast<size_t>(input.gcount()));
+    buffer.erase(0, parser.parseLines(buffer));
+  }
+  parser.parseLine(buffer);
+  parser.finish();
+}
+
+/**
+ * Maps an uncompressed regular file into memory and parses it in place,
+ * anything else, like stdin for path "-", is decompressed on another thread
+ * as it is parsed
+ */
+template <DimacsConsumer Consumer>
+void parseDimacsFile(const std::filesystem::path& path, Consumer& consumer) {
+  if (path != "-") {
+    MappedFile file(path);
+    if (file.isMapped() && compressionOf(file.text()) == Compression::none)
+      return parseDimacsText(file.text(), consumer);
+  }
+  DecompressingInput input(path);
+  parseDimacsFile(input.stream(), consumer);
+}
+///@}
+
+/// @name Parsing into ParsedDimacsFile
+///@{
+ParsedDimacsFile parseDimacsText(std::string_view text);
 ParsedDimacsFile parseDimacsFile(std::istream& input);
+ParsedDimacsFile parseDimacsFile(const std::filesystem::path& path);
+///@}
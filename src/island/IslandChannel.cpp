@@ -0,0 +1,158 @@
+#include "IslandChannel.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace {
+[[noreturn]] void throwErrno(const char* what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+sockaddr_un addressOf(const std::filesystem::path& socketPath) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  const std::string& path = socketPath.native();
+  if (path.size() >= sizeof(address.sun_path))
+    throw std::invalid_argument("Socket path " + path + " is too long");
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  return address;
+}
+}  // namespace
+
+// ===================== IslandChannel =====================
+IslandChannel::IslandChannel(int fd) : fd(fd) {}
+
+IslandChannel::IslandChannel(IslandChannel&& other) noexcept
+    : fd(std::exchange(other.fd, -1)) {}
+
+IslandChannel& IslandChannel::operator=(IslandChannel&& other) noexcept {
+  if (this != &other) {
+    if (fd >= 0) ::close(fd);
+    fd = std::exchange(other.fd, -1);
+  }
+  return *this;
+}
+
+IslandChannel::~IslandChannel() {
+  if (fd >= 0) ::close(fd);
+}
+
+IslandChannel IslandChannel::connect(
+    const std::filesystem::path& socketPath, std::chrono::milliseconds patience
+) {
+  sockaddr_un address = addressOf(socketPath);
+  auto giveUpAt = std::chrono::steady_clock::now() + patience;
+  while (true) {
+    int socketFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socketFd < 0) throwErrno("Cannot create island socket");
+    if (::connect(
+            socketFd,
+            reinterpret_cast<const sockaddr*>(&address),
+            sizeof(address)
+        ) == 0)
+      return IslandChannel(socketFd);
+    int error = errno;
+    ::close(socketFd);
+    // Coordinator not listening yet
+    bool early = error == ENOENT || error == ECONNREFUSED;
+    if (!early || std::chrono::steady_clock::now() >= giveUpAt) {
+      errno = error;
+      throwErrno("Cannot connect to island coordinator");
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+}
+
+void IslandChannel::writeAll(const char* data, size_t size) {
+  while (size > 0) {
+    ssize_t written = ::send(fd, data, size, MSG_NOSIGNAL);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      throwErrno("Cannot write to island socket");
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+}
+
+bool IslandChannel::readAll(char* data, size_t size) {
+  size_t done = 0;
+  while (done < size) {
+    ssize_t got = ::recv(fd, data + done, size - done, 0);
+    if (got < 0) {
+      if (errno == EINTR) continue;
+      throwErrno("Cannot read from island socket");
+    }
+    if (got == 0) {
+      if (done == 0) return false;
+      throw std::invalid_argument("Island message ended unexpectedly");
+    }
+    done += static_cast<size_t>(got);
+  }
+  return true;
+}
+
+void IslandChannel::send(IslandMessage type, std::string_view payload) {
+  uint32_t header[2] = {
+      static_cast<uint32_t>(type), static_cast<uint32_t>(payload.size())
+  };
+  writeAll(reinterpret_cast<const char*>(header), sizeof(header));
+  writeAll(payload.data(), payload.size());
+}
+
+std::optional<IslandEnvelope> IslandChannel::receive() {
+  uint32_t header[2];
+  if (!readAll(reinterpret_cast<char*>(header), sizeof(header)))
+    return std::nullopt;
+  if (header[0] < static_cast<uint32_t>(IslandMessage::hello) ||
+      header[0] > static_cast<uint32_t>(IslandMessage::final))
+    throw std::invalid_argument("Unknown island message");
+  if (header[1] > payloadLimit)
+    throw std::invalid_argument("Island message is too long");
+  IslandEnvelope envelope{static_cast<IslandMessage>(header[0]), {}};
+  envelope.payload.resize(header[1]);
+  if (header[1] > 0 && !readAll(envelope.payload.data(), header[1]))
+    throw std::invalid_argument("Island message ended unexpectedly");
+  return envelope;
+}
+// ===================== EndIslandChannel =====================
+
+// ===================== IslandListener =====================
+IslandListener::IslandListener(std::filesystem::path socketPath)
+    : socketPath(std::move(socketPath)) {
+  sockaddr_un address = addressOf(this->socketPath);
+  fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) throwErrno("Cannot create island socket");
+  std::filesystem::remove(this->socketPath);
+  if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) <
+          0 ||
+      ::listen(fd, SOMAXCONN) < 0) {
+    int error = errno;
+    ::close(fd);
+    errno = error;
+    throwErrno("Cannot listen on island socket");
+  }
+}
+
+IslandListener::~IslandListener() {
+  ::close(fd);
+  std::error_code ignored;
+  std::filesystem::remove(socketPath, ignored);
+}
+
+IslandChannel IslandListener::accept() {
+  while (true) {
+    int channelFd = ::accept4(fd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (channelFd >= 0) return IslandChannel(channelFd);
+    if (errno != EINTR) throwErrno("Cannot accept island worker");
+  }
+}
+// ===================== EndIslandListener =====================
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "IslandProtocol.h"
+
+/** Message with its payload, as received */
+struct IslandEnvelope {
+  IslandMessage type;
+  std::string payload;
+};
+
+/**
+ * Connected Unix domain stream socket carrying framed island messages
+ *
+ * Each message is its type and payload length as uint32_t followed by the
+ * payload. Failures of the socket throw std::system_error.
+ */
+class IslandChannel {
+ private:
+  int fd = -1;
+
+  void writeAll(const char* data, size_t size);
+  /** @return false if the peer closed before the first byte */
+  bool readAll(char* data, size_t size);
+
+ public:
+  /** Longest payload accepted, far above any configuration */
+  static constexpr uint32_t payloadLimit = 1u << 30;
+
+  /** Takes ownership of connected socket */
+  explicit IslandChannel(int fd);
+  IslandChannel(const IslandChannel&) = delete;
+  IslandChannel& operator=(const IslandChannel&) = delete;
+  IslandChannel(IslandChannel&& other) noexcept;
+  IslandChannel& operator=(IslandChannel&& other) noexcept;
+  ~IslandChannel();
+
+  /**
+   * Connects to a coordinator listening on socketPath, retrying while it
+   * does not listen yet for at most patience
+   */
+  static IslandChannel connect(
+      const std::filesystem::path& socketPath,
+      std::chrono::milliseconds patience
+  );
+
+  [[nodiscard]] int descriptor() const { return fd; }
+  void send(IslandMessage type, std::string_view payload = {});
+  /**
+   * Blocks until a whole message arrives
+   *
+   * @return nullopt if the peer closed the connection between messages
+   * @throws std::invalid_argument on a malformed frame
+   */
+  std::optional<IslandEnvelope> receive();
+};
+
+/** Listening Unix domain socket, removed again when destroyed */
+class IslandListener {
+ private:
+  int fd = -1;
+  std::filesystem::path socketPath;
+
+ public:
+  /** Replaces a stale socket file left at socketPath */
+  explicit IslandListener(std::filesystem::path socketPath);
+  IslandListener(const IslandListener&) = delete;
+  IslandListener& operator=(const IslandListener&) = delete;
+  ~IslandListener();
+
+  /** Blocks until a worker connects */
+  IslandChannel accept();
+};
@@ -0,0 +1,89 @@
+#include "IslandCoordinator.h"
+
+#include <poll.h>
+
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+IslandCoordinator::IslandCoordinator(
+    const SatCooling& problem,
+    const std::filesystem::path& socketPath,
+    uint32_t islandCount
+)
+    : problem(problem), listener(socketPath), islands(islandCount) {}
+
+void IslandCoordinator::record(uint32_t index, IslandReport report) {
+  Island& island = islands[index];
+  island.criteria = problem.evaluateFully(report.configuration);
+  island.report = std::move(report);
+  if (!hasElite || eliteCriteria < island.criteria) {
+    elite = island.report.configuration;
+    eliteCriteria = island.criteria;
+    hasElite = true;
+  }
+}
+
+bool IslandCoordinator::serve(uint32_t index) {
+  std::optional<IslandEnvelope> envelope = channels[index].receive();
+  if (!envelope)
+    throw std::invalid_argument("Island left without a final report");
+  switch (envelope->type) {
+    case IslandMessage::report:
+      record(index, decodeReport(problem, envelope->payload));
+      if (eliteCriteria.howMuchWorseThan(islands[index].criteria) < 0) {
+        channels[index].send(
+            IslandMessage::migrant, encodeConfiguration(problem, elite)
+        );
+        migrations++;
+      } else {
+        channels[index].send(IslandMessage::keep);
+      }
+      return true;
+    case IslandMessage::final:
+      record(index, decodeReport(problem, envelope->payload));
+      islands[index].finished = true;
+      return false;
+    default:
+      throw std::invalid_argument("Unexpected island message");
+  }
+}
+
+void IslandCoordinator::run() {
+  for (uint32_t index = 0; index < islands.size(); index++) {
+    IslandChannel channel = listener->accept();
+    std::optional<IslandEnvelope> hello = channel.receive();
+    if (!hello || hello->type != IslandMessage::hello)
+      throw std::invalid_argument("Island did not say hello");
+    channel.send(IslandMessage::welcome, encodeIndex(index));
+    channels.push_back(std::move(channel));
+  }
+  listener.reset();
+
+  uint32_t running = islands.size();
+  std::vector<pollfd> waiting(islands.size());
+  while (running > 0) {
+    for (uint32_t index = 0; index < islands.size(); index++) {
+      // Negative descriptors are skipped by poll
+      int fd = islands[index].finished ? -1 : channels[index].descriptor();
+      waiting[index] = {fd, POLLIN, 0};
+    }
+    if (::poll(waiting.data(), waiting.size(), -1) < 0) {
+      if (errno == EINTR) continue;
+      throw std::system_error(errno, std::generic_category(), "Cannot poll");
+    }
+    for (uint32_t index = 0; index < islands.size(); index++) {
+      if (waiting[index].revents == 0 || islands[index].finished) continue;
+      if (!serve(index)) running--;
+    }
+  }
+}
+
+uint32_t IslandCoordinator::bestIndex() const {
+  uint32_t best = 0;
+  for (uint32_t i = 1; i < islands.size(); i++) {
+    if (islands[best].criteria < islands[i].criteria) best = i;
+  }
+  return best;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "IslandChannel.h"
+#include "IslandProtocol.h"
+#include "SatConfig.h"
+#include "SatCooling.h"
+#include "SatCriteria.h"
+
+/**
+ * Coordinator of the island model, which keeps the elite configuration
+ * reported by any island and sends it to islands reporting worse ones
+ *
+ * Serves all islands from a single thread, a report is answered before the
+ * next message is read, so an island waits only for the coordinator, never
+ * for the other islands.
+ */
+class IslandCoordinator {
+ public:
+  /** Last report of an island, with accessors named like Cooling's */
+  struct Island {
+    IslandReport report;
+    SatCriteria criteria;
+    bool finished = false;
+
+    [[nodiscard]] SatConfig copyBestConfiguration() const {
+      return report.configuration;
+    }
+    [[nodiscard]] const SatCriteria& getBestCriteria() const {
+      return criteria;
+    }
+    [[nodiscard]] uint32_t getStepsTotal() const { return report.stepsTotal; }
+    [[nodiscard]] uint32_t getStepsSinceChange() const {
+      return report.stepsSinceChange;
+    }
+    [[nodiscard]] uint32_t getStepsSinceBetterment() const {
+      return report.stepsSinceBetterment;
+    }
+    [[nodiscard]] const std::string& endedBecause() const {
+      return report.endedBecause;
+    }
+  };
+
+ private:
+  SatCooling problem;
+  /** Closed once all islands joined */
+  std::optional<IslandListener> listener;
+  std::vector<IslandChannel> channels;
+  std::vector<Island> islands;
+  SatConfig elite;
+  SatCriteria eliteCriteria;
+  bool hasElite = false;
+  uint32_t migrations = 0;
+
+  /** Scores report by a full evaluation, reports can't be trusted */
+  void record(uint32_t index, IslandReport report);
+  /** @return false once the island finished */
+  bool serve(uint32_t index);
+
+ public:
+  /** Listens on socketPath right away, so workers may connect early */
+  IslandCoordinator(
+      const SatCooling& problem,
+      const std::filesystem::path& socketPath,
+      uint32_t islandCount
+  );
+
+  /**
+   * Welcomes islandCount workers in the order they connect and serves them
+   * until all sent their final report
+   *
+   * @throws std::invalid_argument if a worker breaks the protocol
+   */
+  void run();
+
+  [[nodiscard]] uint32_t size() const { return islands.size(); }
+  [[nodiscard]] const Island& island(uint32_t index) const {
+    return islands[index];
+  }
+  /** Index of island with the best final criteria, the lowest on ties */
+  [[nodiscard]] uint32_t bestIndex() const;
+  /** Count of migrants sent */
+  [[nodiscard]] uint32_t getMigrations() const { return migrations; }
+};
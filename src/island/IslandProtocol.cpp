@@ -0,0 +1,86 @@
+#include "IslandProtocol.h"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+template <typename T>
+T readValue(std::istream& in) {
+  T value;
+  if (!in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+    throw std::invalid_argument("Island message ended unexpectedly");
+  return value;
+}
+
+/** Rejects payloads longer than what was read of them */
+void expectEnd(std::istream& in) {
+  if (in.peek() != std::istream::traits_type::eof())
+    throw std::invalid_argument("Island message is longer than expected");
+}
+}  // namespace
+
+std::string encodeIndex(uint32_t index) {
+  std::ostringstream out;
+  writeValue(out, index);
+  return out.str();
+}
+
+uint32_t decodeIndex(std::string_view payload) {
+  std::istringstream in{std::string(payload)};
+  auto index = readValue<uint32_t>(in);
+  expectEnd(in);
+  return index;
+}
+
+std::string encodeConfiguration(
+    const SatCooling& problem, const SatConfig& configuration
+) {
+  std::ostringstream out;
+  problem.writeConfiguration(out, configuration);
+  return out.str();
+}
+
+SatConfig decodeConfiguration(
+    const SatCooling& problem, std::string_view payload
+) {
+  std::istringstream in{std::string(payload)};
+  SatConfig configuration = problem.readConfiguration(in);
+  expectEnd(in);
+  return configuration;
+}
+
+std::string encodeReport(
+    const SatCooling& problem, const IslandReport& report
+) {
+  std::ostringstream out;
+  writeValue(out, report.stepsTotal);
+  writeValue(out, report.stepsSinceChange);
+  writeValue(out, report.stepsSinceBetterment);
+  writeValue(out, static_cast<uint32_t>(report.endedBecause.size()));
+  out.write(report.endedBecause.data(), report.endedBecause.size());
+  problem.writeConfiguration(out, report.configuration);
+  return out.str();
+}
+
+IslandReport decodeReport(
+    const SatCooling& problem, std::string_view payload
+) {
+  std::istringstream in{std::string(payload)};
+  IslandReport report;
+  report.stepsTotal = readValue<uint32_t>(in);
+  report.stepsSinceChange = readValue<uint32_t>(in);
+  report.stepsSinceBetterment = readValue<uint32_t>(in);
+  auto reasonLength = readValue<uint32_t>(in);
+  if (reasonLength > payload.size())
+    throw std::invalid_argument("Island message ended unexpectedly");
+  report.endedBecause.resize(reasonLength);
+  if (!in.read(report.endedBecause.data(), reasonLength))
+    throw std::invalid_argument("Island message ended unexpectedly");
+  report.configuration = problem.readConfiguration(in);
+  expectEnd(in);
+  return report;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "SatConfig.h"
+#include "SatCooling.h"
+
+/**
+ * Messages between island workers and their coordinator
+ *
+ * A worker says hello and gets welcome with its island index. Then it
+ * sends a report every few equilibria, answered by a migrant to continue
+ * from or by keep, and a final report once its search is over. Payloads are
+ * binary in native byte order, both sides run on the same machine.
+ */
+enum class IslandMessage : uint32_t {
+  hello = 1,
+  welcome,
+  report,
+  migrant,
+  keep,
+  final,
+};
+
+/** State of the search on an island */
+struct IslandReport {
+  uint32_t stepsTotal = 0;
+  uint32_t stepsSinceChange = 0;
+  uint32_t stepsSinceBetterment = 0;
+  /** Empty until the final report */
+  std::string endedBecause;
+  /**
+   * Best configuration of the island, or the current one while no best is
+   * valid, so unsatisfied islands compete too
+   */
+  SatConfig configuration;
+};
+
+/// @name Payloads
+/// Decoding throws std::invalid_argument on data not matching the instance
+///@{
+[[nodiscard]] std::string encodeIndex(uint32_t index);
+[[nodiscard]] uint32_t decodeIndex(std::string_view payload);
+[[nodiscard]] std::string encodeConfiguration(
+    const SatCooling& problem, const SatConfig& configuration
+);
+[[nodiscard]] SatConfig decodeConfiguration(
+    const SatCooling& problem, std::string_view payload
+);
+[[nodiscard]] std::string encodeReport(
+    const SatCooling& problem, const IslandReport& report
+);
+[[nodiscard]] IslandReport decodeReport(
+    const SatCooling& problem, std::string_view payload
+);
+///@}
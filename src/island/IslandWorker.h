@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "IslandChannel.h"
+#include "IslandProtocol.h"
+#include "SatConfig.h"
+#include "SatCooling.h"
+
+/**
+ * Island of the island model, which drives a chain of its own and exchanges
+ * its best configuration with the coordinator every few equilibria
+ */
+class IslandWorker {
+ private:
+  SatCooling problem;
+  IslandChannel channel;
+  uint32_t islandIndex;
+
+  template <typename Chain>
+  [[nodiscard]] IslandReport reportOf(
+      const Chain& chain, const SatConfig& configuration
+  ) const {
+    return IslandReport{
+        .stepsTotal = chain.getStepsTotal(),
+        .stepsSinceChange = chain.getStepsSinceChange(),
+        .stepsSinceBetterment = chain.getStepsSinceBetterment(),
+        .endedBecause = {},
+        .configuration = configuration,
+    };
+  }
+
+  /** Reports the chain and continues from a migrant, if one comes back */
+  template <typename Chain>
+  void exchange(Chain& chain) {
+    const SatConfig& configuration = chain.getBestCriteria().isValid()
+        ? chain.getBestConfiguration()
+        : chain.getCurrentConfiguration();
+    channel.send(
+        IslandMessage::report,
+        encodeReport(problem, reportOf(chain, configuration))
+    );
+    std::optional<IslandEnvelope> reply = channel.receive();
+    if (!reply) throw std::invalid_argument("Island coordinator left");
+    if (reply->type == IslandMessage::migrant) {
+      chain.moveTo(decodeConfiguration(problem, reply->payload));
+    } else if (reply->type != IslandMessage::keep) {
+      throw std::invalid_argument("Unexpected island message");
+    }
+  }
+
+ public:
+  /**
+   * Joins the coordinator listening on socketPath, waiting at most
+   * patience for it to start listening
+   *
+   * @throws std::invalid_argument if the coordinator breaks the protocol
+   */
+  IslandWorker(
+      const SatCooling& problem,
+      const std::filesystem::path& socketPath,
+      std::chrono::milliseconds patience
+  )
+      : problem(problem),
+        channel(IslandChannel::connect(socketPath, patience)) {
+    channel.send(IslandMessage::hello);
+    std::optional<IslandEnvelope> welcome = channel.receive();
+    if (!welcome || welcome->type != IslandMessage::welcome)
+      throw std::invalid_argument("Island coordinator did not welcome");
+    islandIndex = decodeIndex(welcome->payload);
+  }
+
+  /** Index the coordinator gave this island, unique among its islands */
+  [[nodiscard]] uint32_t index() const { return islandIndex; }
+
+  /**
+   * Runs the chain until its search is over, exchanging after every
+   * exchangeEvery equilibria, if not 0, then sends the final report
+   */
+  template <typename Chain>
+  void run(Chain& chain, uint32_t exchangeEvery) {
+    uint32_t equilibria = 0;
+    while (chain.runEquilibrium()) {
+      equilibria++;
+      if (exchangeEvery != 0 && equilibria % exchangeEvery == 0)
+        exchange(chain);
+    }
+    IslandReport final = reportOf(chain, chain.getBestConfiguration());
+    final.endedBecause = chain.endedBecause();
+    channel.send(IslandMessage::final, encodeReport(problem, final));
+  }
+};
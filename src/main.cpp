@@ -1,24 +1,111 @@
 #include <SatCooling.h>
 
 #include <CLI/CLI.hpp>
+#include <chrono>
+#include <cmath>
+#include <csignal>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #include "Cooling.h"
+#include "IslandCoordinator.h"
+#include "IslandWorker.h"
+#include "ParallelTempering.h"
+#include "Portfolio.h"
 #include "Rng.h"
+#include "SatLockstep.h"
+#include "SatSharedBest.h"
 #include "dimacsParsing.h"
 
+namespace {
+/** Set by SIGTERM and SIGINT, the search checkpoints and ends */
+volatile std::sig_atomic_t stopRequested = 0;
+void requestStop(int /*signal*/) { stopRequested = 1; }
+
+/** Instance in the MWSAT format, possibly compressed, or its image */
+std::shared_ptr<const WSatInstance> loadInstance(
+    const std::filesystem::path& path
+) {
+  if (WSatInstance::isImage(path))
+    return std::make_shared<const WSatInstance>(WSatInstance::loadImage(path));
+  WSatInstance::Builder builder;
+  parseDimacsFile(path, builder);
+  return std::make_shared<const WSatInstance>(std::move(builder).build());
+}
+
+/** Writes the binary image of an instance, later runs load it by -f */
+int compile(int argc, char** argv) {
+  CLI::App app{
+      "Compiles an instance in the MWSAT format into a binary image, which "
+      "--file of a run then maps instead of parsing it"
+  };
+
+  std::filesystem::path inputPath;
+  app.add_option(
+         "-f,--file",
+         inputPath,
+         "Path to instance in the MWSAT format, possibly gzip, xz or zstd "
+         "compressed, - for stdin"
+  )
+      ->required();
+  std::filesystem::path outputPath;
+  app.add_option("-o,--output", outputPath, "Path to write the image to")
+      ->required();
+
+  CLI11_PARSE(app, argc, argv);
+
+  if (inputPath != "-" && !exists(inputPath)) {
+    std::cerr << "Input file " << inputPath << " does not exist" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::shared_ptr<const WSatInstance> instance;
+  try {
+    instance = loadInstance(inputPath);
+  } catch (const std::exception& e) {
+    std::cerr << "Cannot load " << inputPath << ": " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::ofstream out(outputPath, std::ios::binary);
+  instance->writeImage(out);
+  out.close();
+  if (!out) {
+    std::cerr << "Cannot write image " << outputPath << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+}  // namespace
+
 int main(int argc, char** argv) {
+  if (argc > 1 && std::string_view(argv[1]) == "compile") {
+    return compile(argc - 1, argv + 1);
+  }
+
   CLI::App app{
       "Solves maximum weighted sat instances in the MWSAT format using "
       "simulated cooling method.\n\n The result is printed in the format of "
-      "<inputFileName> <weight> <variable1> <variable2> ... <variableN>"
+      "<inputFileName> <weight> <variable1> <variable2> ... <variableN>\n\n "
+      "Run with compile as the first argument to compile an instance into a "
+      "binary image instead, see compile --help"
   };
 
   std::string inputFileName;
   app.add_option(
-         "-f,--file", inputFileName, "Path to instance in the MWSAT format"
+         "-f,--file",
+         inputFileName,
+         "Path to instance in the MWSAT format, possibly gzip, xz or zstd "
+         "compressed, - for stdin, or to its image made by compile"
   )
       ->required();
 
@@ -65,6 +152,150 @@ int main(int argc, char** argv) {
       "End after steps without change, if 0 then infinite"
   );
 
+  double walkProbability = 0;
+  app.add_option(
+      "-p,--walkProbability",
+      walkProbability,
+      "Probability of flipping a variable of a random unsatisfied clause "
+      "instead of any variable, if 0 then always any variable"
+  );
+
+  uint32_t randomStarts = 1;
+  app.add_option(
+      "-r,--randomStarts",
+      randomStarts,
+      "Start from the best of this many random configurations"
+  );
+
+  uint32_t threads = 1;
+  app.add_option(
+      "-j,--threads",
+      threads,
+      "Run this many independent chains in parallel and report the best, "
+      "the result only depends on the seed and this count"
+  );
+
+  double temperatureSpread = 1;
+  app.add_option(
+      "-S,--temperatureSpread",
+      temperatureSpread,
+      "Chain i starts at startTemperature * temperatureSpread^i"
+  );
+
+  uint32_t replicas = 1;
+  app.add_option(
+      "-R,--replicas",
+      replicas,
+      "If more than 1, run parallel tempering of this many replicas at fixed "
+      "temperatures spaced geometrically from endTemperature to "
+      "startTemperature instead of cooling, replicas do equilibrium steps "
+      "between swaps and maxIterations steps in total, which is required"
+  );
+
+  double timeLimit = 0;
+  app.add_option(
+      "-l,--timeLimit",
+      timeLimit,
+      "End after this many seconds, checked once per equilibrium, if 0 then "
+      "infinite"
+  );
+
+  int32_t targetWeight = 0;
+  CLI::Option* targetOption = app.add_option(
+      "-g,--targetWeight",
+      targetWeight,
+      "End once a satisfying configuration of at least this weight is found"
+  );
+
+  std::filesystem::path checkpointPath;
+  CLI::Option* checkpointOption = app.add_option(
+      "-k,--checkpoint",
+      checkpointPath,
+      "Where to write a checkpoint of the search, when an equilibrium ends "
+      "after SIGTERM or SIGINT, which also ends the run, or every "
+      "checkpointEvery equilibria, single chain only"
+  );
+
+  uint32_t checkpointEvery = 0;
+  app.add_option(
+      "-K,--checkpointEvery",
+      checkpointEvery,
+      "Equilibria between checkpoints, if 0 then only on a signal"
+  );
+
+  std::filesystem::path resumePath;
+  CLI::Option* resumeOption = app.add_option(
+      "--resume",
+      resumePath,
+      "Continue the search from a checkpoint, the instance and the other "
+      "options must be the same as in the run which wrote it, the result "
+      "is then the same as if the run was never interrupted"
+  );
+
+  std::string scheduleName = "geometric";
+  app.add_option(
+      "-C,--schedule",
+      scheduleName,
+      "Cooling schedule, one of: geometric|lundyMees|lam|adaptiveEquilibrium. "
+      "lundyMees does T / (1 + beta T) reaching endTemperature in as many "
+      "equilibria as geometric, lam keeps the acceptance rate on a target "
+      "profile over maxIterations, which is required, adaptiveEquilibrium "
+      "ends an equilibrium early after a tenth of its steps got accepted or "
+      "a tenth passed without any"
+  );
+
+  uint32_t lanes = 1;
+  app.add_option(
+      "-L,--lanes",
+      lanes,
+      "One of: 1|4|8. More than 1 advances this many chains in lockstep on "
+      "each thread, chain i of thread t is chain t * lanes + i for seeds and "
+      "temperatures, lanes flip any variable and cool geometrically, "
+      "without debug output, checkpoints, time limit or target"
+  );
+
+  uint32_t cooperate = 0;
+  app.add_option(
+      "--cooperate",
+      cooperate,
+      "Chains share the best configuration any of them found, ranked by "
+      "satisfied clauses and then by weight, unlike the final comparison "
+      "of criteria, a chain ranked below it continues from it every this "
+      "many equilibria, which makes the result depend on thread timing, if "
+      "0 then chains are independent"
+  );
+
+  std::filesystem::path coordinatePath;
+  CLI::Option* coordinateOption = app.add_option(
+      "--coordinate",
+      coordinatePath,
+      "Coordinate islands joining over this Unix socket instead of "
+      "searching, the best configuration any island reported goes to "
+      "islands reporting worse ones, the best final one is printed"
+  );
+
+  uint32_t islands = 0;
+  app.add_option(
+      "--islands", islands, "Count of islands the coordinator waits for"
+  );
+
+  std::filesystem::path joinPath;
+  CLI::Option* joinOption = app.add_option(
+      "--join",
+      joinPath,
+      "Search as an island of the coordinator listening on this Unix "
+      "socket, waiting up to 10 seconds for it, island i is chain i for "
+      "seeds and temperatures, nothing is printed"
+  );
+
+  uint32_t exchangeEvery = 10;
+  app.add_option(
+      "--exchangeEvery",
+      exchangeEvery,
+      "Equilibria between exchanges of an island with its coordinator, if 0 "
+      "then only the final result is sent"
+  );
+
   bool extendedOutput = false;
   app.add_option(
       "-E, --extendedOutput",
@@ -72,16 +303,75 @@ int main(int argc, char** argv) {
       "Show extended output after completion in the format of: \n"
       "First line is normal <fileName> <weight> <variable1> ... <variableN>. \n"
       "Second line is <endedBecause> <isSatisfied> <satisfiedCount> \n"
-      "<stepsTotal> <stepsSinceChange> <stepsSinceGain>, \n"
-      "where endedBecause is one of: temperature|max|change|gain|unknown"
+      "<stepsTotal> <stepsSinceChange> <stepsSinceGain> <elapsedSeconds>, \n"
+      "where endedBecause is one of: \n"
+      "target|time|temperature|max|change|gain|unknown. \n"
+      "With more threads or lanes a line <chain> <endedBecause> <weight> \n"
+      "<satisfiedCount> <stepsTotal> follows for each chain. \n"
+      "With islands a line <island> <endedBecause> <weight> \n"
+      "<satisfiedCount> <stepsTotal> follows for each island. \n"
+      "With replicas a line <coldTemperature> <hotTemperature> \n"
+      "<swapAcceptanceRate> follows for each pair of neighboring temperatures"
   );
 
   CLI11_PARSE(app, argc, argv);
 
+  if (replicas > 1 && maxIterations == 0) {
+    std::cerr << "Parallel tempering needs --maxIterations" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (scheduleName != "geometric" && scheduleName != "lundyMees" &&
+      scheduleName != "lam" && scheduleName != "adaptiveEquilibrium") {
+    std::cerr << "Unknown schedule " << scheduleName << std::endl;
+    return EXIT_FAILURE;
+  }
+  if ((*checkpointOption || *resumeOption) && (threads > 1 || replicas > 1)) {
+    std::cerr << "Checkpoints need a single chain" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (lanes != 1 && lanes != 4 && lanes != 8) {
+    std::cerr << "Lanes must be 1, 4 or 8" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (lanes > 1 &&
+      (replicas > 1 || *debugOption || *checkpointOption || *resumeOption ||
+       timeLimit > 0 || *targetOption || walkProbability > 0 ||
+       scheduleName != "geometric")) {
+    std::cerr << "Lanes support only geometric cooling of any variable flips, "
+                 "without replicas, debug output, checkpoints, time limit "
+                 "or target"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (cooperate > 0 && (replicas > 1 || lanes > 1 || *joinOption ||
+                        *debugOption || *checkpointOption || *resumeOption)) {
+    std::cerr << "Cooperation is for portfolio chains, without debug output "
+                 "or checkpoints"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (*coordinateOption && islands == 0) {
+    std::cerr << "Coordinator needs --islands" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (*joinOption &&
+      (*coordinateOption || threads > 1 || replicas > 1 || lanes > 1 ||
+       *debugOption || *checkpointOption || *resumeOption)) {
+    std::cerr << "Island runs a single chain, without debug output or "
+                 "checkpoints"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (scheduleName == "lam" && maxIterations == 0) {
+    std::cerr << "Schedule lam needs --maxIterations" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   // Steps correction
   if (maxIterations == 0) maxIterations = UINT32_MAX;
   if (withoutChange == 0) withoutChange = UINT32_MAX;
   if (withoutGain == 0) withoutGain = UINT32_MAX;
+  if (threads == 0) threads = 1;
 
   // Check input path
   auto hello = std::ranges::views::drop_while(inputFileName, [](char c) {
@@ -89,30 +379,79 @@ int main(int argc, char** argv) {
   });
   std::string world(hello.begin(), hello.end());
   std::filesystem::path inputPath(world);
-  if (!exists(inputPath)) {
+  if (inputPath != "-" && !exists(inputPath)) {
     std::cerr << "Input file " << inputPath << " does not exist" << std::endl;
     return EXIT_FAILURE;
   }
 
+  if (*resumeOption && !exists(resumePath)) {
+    std::cerr << "Checkpoint " << resumePath << " does not exist" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Checkpoints are written aside first, found unwritable before searching
+  std::filesystem::path partialPath = checkpointPath;
+  partialPath += ".partial";
+  if (*checkpointOption) {
+    if (!std::ofstream(partialPath, std::ios::binary)) {
+      std::cerr << "Cannot write checkpoint " << partialPath << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::error_code ignored;
+    std::filesystem::remove(partialPath, ignored);
+  }
+
   // Set seed
-  Rng::deserializeSeed(seedStr);
+  Rng rng = Rng::fromSerializedSeed(seedStr);
 
   // Prepare cooling
-  std::ifstream inputStream(inputPath.c_str());
-  ParsedDimacsFile input = parseDimacsFile(inputStream);
-  CoolingSchedule schedule(
-      equilibrium,
-      cooling,
-      startTemperature,
-      endTemperature,
-      maxIterations,
-      withoutChange,
-      withoutGain
-  );
-  SatCooling satCooling(input.clauses, input.weights);
-  Cooling<SatConfig, SatCriteria, SatCooling> simulatedCooling(
-      satCooling, schedule
-  );
+  std::shared_ptr<const WSatInstance> instance;
+  try {
+    instance = loadInstance(inputPath);
+  } catch (const std::exception& e) {
+    std::cerr << "Cannot load " << inputPath << ": " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  SatCooling satCooling(instance, walkProbability);
+
+  // Search time, without parsing the input
+  auto startedAt = std::chrono::steady_clock::now();
+  auto elapsedSeconds = [&] {
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now() - startedAt
+    )
+        .count();
+  };
+
+  // Setup checkpoints
+  if (*checkpointOption) {
+    std::signal(SIGTERM, requestStop);
+    std::signal(SIGINT, requestStop);
+  }
+  bool interrupted = false;
+  // Written aside first, so a kill or a failed write keeps the last
+  // checkpoint, throws std::runtime_error if it cannot be written
+  auto writeCheckpoint = [&](const auto& simulatedCooling) {
+    std::error_code error;
+    {
+      std::ofstream out(partialPath, std::ios::binary);
+      simulatedCooling.saveCheckpoint(out);
+      out.close();
+      if (!out) {
+        std::filesystem::remove(partialPath, error);
+        throw std::runtime_error("Cannot write " + partialPath.string());
+      }
+    }
+    std::filesystem::rename(partialPath, checkpointPath, error);
+    if (error) {
+      std::string reason = error.message();
+      std::filesystem::remove(partialPath, error);
+      throw std::runtime_error(
+          "Cannot rename " + partialPath.string() + " to " +
+          checkpointPath.string() + ": " + reason
+      );
+    }
+  };
 
   // Setup debug output
   bool debugEnabled = false;
@@ -122,49 +461,313 @@ int main(int argc, char** argv) {
     debugStream = std::ofstream(debugPath.c_str());
   }
 
-  // Simulated cooling main loop
-  while (simulatedCooling.step()) {
-    if (debugEnabled) {
-      const SatCriteria& current = simulatedCooling.getCurrentCriteria();
-      const SatCriteria& best = simulatedCooling.getBestCriteria();
-      debugStream << simulatedCooling.getStepsTotal() << " "
-                  << current.satisfied() << " " << current.weight() << " "
-                  << best.weight() << std::endl;
+  // Verifies and prints the best configuration of given chain, printDetails
+  // adds engine specific lines to the extended output
+  auto report = [&](const auto& simulatedCooling,
+                    const std::string& endedBecause,
+                    const auto& printDetails) {
+    double elapsed = elapsedSeconds();
+    // Verify the incrementally maintained criteria by a full evaluation
+    SatConfig config = simulatedCooling.copyBestConfiguration();
+    SatCriteria finalCriteria = satCooling.evaluateFully(config);
+    const SatCriteria& bestCriteria = simulatedCooling.getBestCriteria();
+    if (finalCriteria.satisfied() != bestCriteria.satisfied() ||
+        finalCriteria.weight() != bestCriteria.weight()) {
+      std::cerr << "Best configuration evaluates to " << finalCriteria
+                << ", but the search reported " << bestCriteria << std::endl;
+      return EXIT_FAILURE;
     }
-  }
-
-  SatCriteria finalCriteria = simulatedCooling.copyBestCriteria();
 #ifdef DEBUG_ENABLED
-  std::cout << "SatisfiedCount: " << finalCriteria.satisfied() << std::endl;
-  std::cout << "Weight: " << finalCriteria.weight() << std::endl;
-  std::cout << "Ended after " << simulatedCooling.getStepsTotal()
-            << " iterations" << std::endl;
-  std::cout << "Steps since change: " << simulatedCooling.getStepsSinceChange()
-            << std::endl;
-  std::cout << "Steps since betterment: "
-            << simulatedCooling.getStepsSinceBetterment() << std::endl;
+    std::cout << "SatisfiedCount: " << finalCriteria.satisfied() << std::endl;
+    std::cout << "Weight: " << finalCriteria.weight() << std::endl;
+    std::cout << "Ended after " << simulatedCooling.getStepsTotal()
+              << " iterations" << std::endl;
+    std::cout << "Steps since change: "
+              << simulatedCooling.getStepsSinceChange() << std::endl;
+    std::cout << "Steps since betterment: "
+              << simulatedCooling.getStepsSinceBetterment() << std::endl;
 #endif
 
-  // Standard print
-  std::cout << inputPath.filename().string() << " " << finalCriteria.weight()
-            << " ";
-  SatConfig config = simulatedCooling.copyBestConfiguration();
-  for (int i = 1; i < config.underlying.size() + 1; i++) {
-    if (config.underlying[i - 1] == true)
-      std::cout << i;
-    else
-      std::cout << -i;
-    if (i != config.underlying.size()) std::cout << " ";
-  }
-
-  if (extendedOutput) {
-    std::cout << std::endl;
-    std::cout << simulatedCooling.endedBecause() << " "
-              << finalCriteria.isSatisfied() << " " << finalCriteria.satisfied()
-              << " " << simulatedCooling.getStepsTotal() << " "
-              << simulatedCooling.getStepsSinceChange() << " "
-              << simulatedCooling.getStepsSinceBetterment() << std::endl;
+    // Standard print
+    std::cout << inputPath.filename().string() << " "
+              << finalCriteria.weight() << " ";
+    for (int i = 1; i < config.size() + 1; i++) {
+      if (config.byId(i))
+        std::cout << i;
+      else
+        std::cout << -i;
+      if (i != config.size()) std::cout << " ";
+    }
+
+    if (extendedOutput) {
+      std::cout << std::endl;
+      std::cout << endedBecause << " " << finalCriteria.isSatisfied() << " "
+                << finalCriteria.satisfied() << " "
+                << simulatedCooling.getStepsTotal() << " "
+                << simulatedCooling.getStepsSinceChange() << " "
+                << simulatedCooling.getStepsSinceBetterment() << " "
+                << elapsed << std::endl;
+      printDetails();
+    }
+    return 0;
+  };
+
+  // Island coordinator, the islands search
+  if (*coordinateOption) {
+    IslandCoordinator coordinator(satCooling, coordinatePath, islands);
+    try {
+      coordinator.run();
+    } catch (const std::exception& error) {
+      std::cerr << "Coordinating islands failed: " << error.what()
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    const IslandCoordinator::Island& best =
+        coordinator.island(coordinator.bestIndex());
+    return report(best, best.endedBecause(), [&] {
+      for (uint32_t i = 0; i < coordinator.size(); i++) {
+        const IslandCoordinator::Island& island = coordinator.island(i);
+        std::cout << i << " " << island.endedBecause() << " "
+                  << island.getBestCriteria().weight() << " "
+                  << island.getBestCriteria().satisfied() << " "
+                  << island.getStepsTotal() << std::endl;
+      }
+    });
+  }
+
+  // Parallel tempering
+  if (replicas > 1) {
+    using SatTempering = ParallelTempering<SatConfig, SatCriteria, SatCooling>;
+    SatTempering tempering(
+        satCooling,
+        SatTempering::geometricLadder(
+            endTemperature, startTemperature, replicas
+        ),
+        rng
+    );
+    if (timeLimit > 0) {
+      tempering.setDeadline(
+          startedAt +
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(timeLimit)
+          )
+      );
+    }
+    if (*targetOption)
+      tempering.setTarget(satCooling.satisfiedWithWeight(targetWeight));
+    tempering.run(maxIterations / equilibrium, equilibrium, threads);
+    return report(tempering.best(), tempering.endedBecause(), [&] {
+      for (uint32_t k = 0; k + 1 < tempering.size(); k++) {
+        std::cout << tempering.temperature(k) << " "
+                  << tempering.temperature(k + 1) << " "
+                  << tempering.pairStats(k).acceptanceRate() << std::endl;
+      }
+    });
   }
 
-  return 0;
-}
\ No newline at end of file
+  // Lockstep lanes, each thread advances Lanes chains
+  auto lockstep = [&]<uint32_t Lanes>(std::integral_constant<uint32_t, Lanes>) {
+    using Engine = SatLockstep<Lanes>;
+    std::vector<std::optional<Engine>> engines(threads);
+    {
+      std::vector<std::jthread> workers;
+      workers.reserve(threads);
+      Rng engineRng = rng;
+      for (uint32_t t = 0; t < threads; t++) {
+        workers.emplace_back([&, t, engineRng] {
+          CoolingSchedule schedule(
+              equilibrium,
+              cooling,
+              startTemperature * std::pow(temperatureSpread, t * Lanes),
+              endTemperature,
+              maxIterations,
+              withoutChange,
+              withoutGain
+          );
+          engines[t].emplace(
+              instance, schedule, engineRng, randomStarts, temperatureSpread
+          );
+          engines[t]->simulateCooling();
+        });
+        for (uint32_t k = 0; k < Lanes; k++) engineRng.jump();
+      }
+    }
+    // Lowest chain index on ties, as with a portfolio
+    uint32_t bestEngine = 0;
+    for (uint32_t t = 1; t < threads; t++) {
+      if (engines[bestEngine]->lane(engines[bestEngine]->bestLane())
+              .getBestCriteria() <
+          engines[t]->lane(engines[t]->bestLane()).getBestCriteria())
+        bestEngine = t;
+    }
+    auto best = engines[bestEngine]->lane(engines[bestEngine]->bestLane());
+    return report(best, best.endedBecause(), [&] {
+      for (uint32_t t = 0; t < threads; t++) {
+        for (uint32_t k = 0; k < Lanes; k++) {
+          auto lane = engines[t]->lane(k);
+          std::cout << t * Lanes + k << " " << lane.endedBecause() << " "
+                    << lane.getBestCriteria().weight() << " "
+                    << lane.getBestCriteria().satisfied() << " "
+                    << lane.getStepsTotal() << std::endl;
+        }
+      }
+    });
+  };
+  if (lanes == 4) return lockstep(std::integral_constant<uint32_t, 4>());
+  if (lanes == 8) return lockstep(std::integral_constant<uint32_t, 8>());
+
+  // Simulated cooling, debug output follows the first chain of a portfolio
+  auto cool = [&]<SchedulePolicy Schedule>(std::type_identity<Schedule>) {
+    using SatPortfolio =
+        Portfolio<SatConfig, SatCriteria, SatCooling, Schedule>;
+    using Chain = typename SatPortfolio::Chain;
+    // Checkpoint and stop handling @return false if run is interrupted
+    uint32_t equilibria = 0;
+    std::string checkpointError;
+    auto checkpointAfterEquilibrium = [&](const Chain& simulatedCooling) {
+      if (!*checkpointOption) return true;
+      equilibria++;
+      if (stopRequested ||
+          (checkpointEvery != 0 && equilibria % checkpointEvery == 0)) {
+        try {
+          writeCheckpoint(simulatedCooling);
+        } catch (const std::exception& error) {
+          checkpointError = error.what();
+          return false;
+        }
+      }
+      interrupted = stopRequested;
+      return !interrupted;
+    };
+    // Island i continues the chain numbering of a portfolio
+    std::optional<IslandWorker> island;
+    uint32_t firstChain = 0;
+    Rng chainsRng = rng;
+    std::string islandError;
+    std::string resumeError;
+    if (*joinOption) {
+      try {
+        island.emplace(satCooling, joinPath, std::chrono::seconds(10));
+      } catch (const std::exception& error) {
+        std::cerr << "Joining islands failed: " << error.what() << std::endl;
+        return EXIT_FAILURE;
+      }
+      firstChain = island->index();
+      for (uint32_t i = 0; i < firstChain; i++) chainsRng.jump();
+    }
+    std::optional<SatSharedBest> shared;
+    if (cooperate > 0) shared.emplace(instance->variableCount());
+    SatPortfolio portfolio(threads);
+    try {
+      portfolio.run(
+          chainsRng,
+          [&](uint32_t chain, Rng chainRng) {
+            CoolingSchedule schedule(
+                equilibrium,
+                cooling,
+                startTemperature *
+                    std::pow(temperatureSpread, firstChain + chain),
+                endTemperature,
+                maxIterations,
+                withoutChange,
+                withoutGain
+            );
+            if (timeLimit > 0) {
+              schedule.stopAfterTime = std::chrono::duration_cast<
+                  std::chrono::steady_clock::duration>(
+                  std::chrono::duration<double>(timeLimit)
+              );
+            }
+            SatConfig start =
+                satCooling.getBestRandomConfiguration(randomStarts, chainRng);
+            Chain simulatedCooling(satCooling, start, schedule, chainRng);
+            if (*targetOption)
+              simulatedCooling.setTarget(
+                  satCooling.satisfiedWithWeight(targetWeight)
+              );
+            if (*resumeOption) {
+              // Reported apart from errors of the search
+              try {
+                std::ifstream in(resumePath, std::ios::binary);
+                simulatedCooling.loadCheckpoint(in);
+              } catch (const std::exception& error) {
+                resumeError = error.what();
+              }
+            }
+            return simulatedCooling;
+          },
+          [&](Chain& simulatedCooling, uint32_t chain) {
+            if (!resumeError.empty()) return;
+            if (shared) {
+              runCooperating(simulatedCooling, *shared, cooperate);
+              return;
+            }
+            if (island) {
+              try {
+                island->run(simulatedCooling, exchangeEvery);
+              } catch (const std::exception& error) {
+                islandError = error.what();
+              }
+              return;
+            }
+            if (debugEnabled && chain == 0) {
+              while (simulatedCooling.step()) {
+                const SatCriteria& current =
+                    simulatedCooling.getCurrentCriteria();
+                const SatCriteria& best = simulatedCooling.getBestCriteria();
+                debugStream << simulatedCooling.getStepsTotal() << " "
+                            << current.satisfied() << " " << current.weight()
+                            << " " << best.weight() << std::endl;
+                if (simulatedCooling.getStepsInEquilibrium() == 0 &&
+                    !checkpointAfterEquilibrium(simulatedCooling))
+                  return;
+              }
+              return;
+            }
+            while (simulatedCooling.runEquilibrium()) {
+              if (!checkpointAfterEquilibrium(simulatedCooling)) return;
+            }
+          }
+      );
+    } catch (const std::exception& error) {
+      std::cerr << "Search failed: " << error.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!resumeError.empty()) {
+      std::cerr << "Loading checkpoint failed: " << resumeError << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!checkpointError.empty()) {
+      std::cerr << "Writing checkpoint failed: " << checkpointError
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    // The coordinator prints the result
+    if (!islandError.empty()) {
+      std::cerr << "Island failed: " << islandError << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (island) return 0;
+    if (interrupted) {
+      std::cerr << "Interrupted, checkpoint written to " << checkpointPath
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    const Chain& best = portfolio.chain(portfolio.bestIndex());
+    return report(best, best.endedBecause(), [&] {
+      for (uint32_t i = 0; threads > 1 && i < portfolio.size(); i++) {
+        const Chain& chain = portfolio.chain(i);
+        std::cout << i << " " << chain.endedBecause() << " "
+                  << chain.getBestCriteria().weight() << " "
+                  << chain.getBestCriteria().satisfied() << " "
+                  << chain.getStepsTotal() << std::endl;
+      }
+    });
+  };
+  if (scheduleName == "lundyMees")
+    return cool(std::type_identity<LundyMeesCooling>());
+  if (scheduleName == "lam") return cool(std::type_identity<LamCooling>());
+  if (scheduleName == "adaptiveEquilibrium")
+    return cool(std::type_identity<AdaptiveEquilibrium>());
+  return cool(std::type_identity<GeometricCooling>());
+}
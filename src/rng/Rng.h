@@ -1,20 +1,136 @@
 #pragma once
 
-#include <fstream>
-#include <memory>
-#include <optional>
+#include <array>
+#include <bit>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <ranges>
+#include <stdexcept>
+#include <string>
 
-/** Facade for xoshiro256plus generator */
+/**
+ * xoshiro256+ generator as a value type
+ *
+ * Produces the same numbers as xoshiro256plus.c for the same seed, but the
+ * state lives in the object, so calls inline and every search can own an
+ * independent stream.
+ */
 class Rng {
  public:
-  static std::array<uint64_t, 4> getState();
-
-  static uint64_t next();
-  static double nextDouble();
-  /** Returns a double in the range of (0, 1) */
-  static double nextDoublePercent();
-  /** @return true on success */
-  static void initWithSeed(uint64_t seed);
-  static void deserializeSeed(std::string seed);
-  static void initWithState(std::array<uint64_t, 4> state);
+  using State = std::array<uint64_t, 4>;
+
+ private:
+  State s;
+
+  static uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  /** Applies the jump polynomial, see rng_jump() */
+  void jumpBy(const State& polynomial) {
+    State jumped{};
+    for (uint64_t word : polynomial) {
+      for (int b = 0; b < 64; b++) {
+        if (word & uint64_t{1} << b) {
+          for (int i = 0; i < 4; i++) jumped[i] ^= s[i];
+        }
+        next();
+      }
+    }
+    s = jumped;
+  }
+
+ public:
+  /** State must not be all zeros */
+  explicit Rng(const State& state) : s(state) {}
+
+  /**
+   * Fills the state from splitmix64 seeded by the seed, last word first,
+   * which is the order GCC evaluated the arguments of rng_set_state_uint()
+   * in, so seeds keep reproducing earlier results
+   */
+  static Rng fromSeed(uint64_t seed) {
+    State state;
+    for (uint64_t& word : state | std::views::reverse) {
+      uint64_t z = (seed += 0x9e3779b97f4a7c15);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      word = z ^ (z >> 31);
+    }
+    return Rng(state);
+  }
+  /** Parses 64-bit hex seed like "0x0123456789abcdef" */
+  static Rng fromSerializedSeed(const std::string& seed) {
+    uint64_t parsed;
+    if (std::sscanf(seed.c_str(), " %" SCNx64, &parsed) != 1)
+      throw std::invalid_argument("Seed is not a hexadecimal number");
+    return fromSeed(parsed);
+  }
+
+  [[nodiscard]] const State& state() const { return s; }
+  void setState(const State& state) { s = state; }
+
+  uint64_t next() {
+    const uint64_t result = s[0] + s[3];
+    const uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+  }
+  /** Uniform in [0, 1) from the upper 53 bits */
+  double nextDouble() {
+    return static_cast<double>(next() >> 11) * 0x1.0p-53;
+  }
+
+  /**
+   * Exponentially distributed with mean 1, that is -ln(u) for u uniform in
+   * (0, 1], by a branchless series with absolute error below 1e-7
+   *
+   * Accepting with probability exp(-x) is then nextExponential() > x, which
+   * spares an exp() per decision for one division.
+   */
+  double nextExponential() { return exponentialFrom(next()); }
+  /** Transform behind nextExponential() of a uniformly random word */
+  static double exponentialFrom(uint64_t random) {
+    double u = static_cast<double>((random >> 11) + 1) * 0x1.0p-53;
+    auto bits = std::bit_cast<uint64_t>(u);
+    auto exponent = static_cast<double>(static_cast<int64_t>(bits >> 52));
+    exponent -= 1023;
+    double mantissa =
+        std::bit_cast<double>((bits & 0x000fffffffffffff) | 0x3ff0000000000000);
+    // ln(m) = 2 atanh(t) for t = (m - 1) / (m + 1), t in [0, 1/3)
+    double t = (mantissa - 1) / (mantissa + 1);
+    double t2 = t * t;
+    double series = 1.0 / 11 + t2 * (1.0 / 13);
+    series = 1.0 / 9 + t2 * series;
+    series = 1.0 / 7 + t2 * series;
+    series = 1.0 / 5 + t2 * series;
+    series = 1.0 / 3 + t2 * series;
+    double lnMantissa = 2 * t * (1 + t2 * series);
+    return -(exponent * 0.6931471805599453 + lnMantissa);
+  }
+
+  /** Skips 2^128 numbers, which splits the stream for parallel use */
+  void jump() {
+    jumpBy({
+        0x180ec6d33cfd0aba,
+        0xd5a61266f0c9392c,
+        0xa9582618e03fc9aa,
+        0x39abdc4529b1661c,
+    });
+  }
+  /** Skips 2^192 numbers, giving starting points for further jump() */
+  void longJump() {
+    jumpBy({
+        0x76e15d3efefdcbbf,
+        0xc5004e441c522fb3,
+        0x77710069854ee241,
+        0x39109bb02acbe635,
+    });
+  }
 };
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "Rng.h"
+
+/**
+ * Lanes independent xoshiro256+ streams stored as structure of arrays, so
+ * one call advances all of them with loops the compiler vectorizes
+ *
+ * Lane k produces the same numbers as the Rng it was created from.
+ */
+template <uint32_t Lanes>
+class RngLanes {
+ public:
+  template <typename T>
+  using PerLane = std::array<T, Lanes>;
+
+ private:
+  PerLane<uint64_t> s0;
+  PerLane<uint64_t> s1;
+  PerLane<uint64_t> s2;
+  PerLane<uint64_t> s3;
+
+ public:
+  explicit RngLanes(std::span<const Rng, Lanes> streams) {
+    for (uint32_t k = 0; k < Lanes; k++) {
+      const Rng::State& state = streams[k].state();
+      s0[k] = state[0];
+      s1[k] = state[1];
+      s2[k] = state[2];
+      s3[k] = state[3];
+    }
+  }
+
+  /** Stream continuing where lane k is */
+  [[nodiscard]] Rng lane(uint32_t k) const {
+    return Rng({s0[k], s1[k], s2[k], s3[k]});
+  }
+
+  void next(PerLane<uint64_t>& out) {
+    for (uint32_t k = 0; k < Lanes; k++) {
+      out[k] = s0[k] + s3[k];
+      uint64_t t = s1[k] << 17;
+      s2[k] ^= s0[k];
+      s3[k] ^= s1[k];
+      s1[k] ^= s2[k];
+      s0[k] ^= s3[k];
+      s2[k] ^= t;
+      s3[k] = (s3[k] << 45) | (s3[k] >> 19);
+    }
+  }
+
+  /** Uniform in [0, bound) for each lane, by the upper 32 bits */
+  void nextBelow(uint32_t bound, PerLane<uint32_t>& out) {
+    PerLane<uint64_t> random;
+    next(random);
+    for (uint32_t k = 0; k < Lanes; k++)
+      out[k] = static_cast<uint32_t>(((random[k] >> 32) * bound) >> 32);
+  }
+
+  /** Lane k gets Rng::exponentialFrom() of its next number */
+  void nextExponential(PerLane<double>& out) {
+    PerLane<uint64_t> random;
+    next(random);
+    for (uint32_t k = 0; k < Lanes; k++) {
+      out[k] = Rng::exponentialFrom(random[k]);
+    }
+  }
+};
@@ -38,7 +38,8 @@ static inline uint64_t rotl(const uint64_t x, int k) {
 }
 
 /* static uint64_t s[4]; */
-static rng_state_t state;
+/* Thread local, so that parallel searches do not share one stream */
+static _Thread_local rng_state_t state;
 
 void rng_set_state_uint (uint64_t s0, uint64_t s1, uint64_t s2, uint64_t s3) {
 	state.s[0] = s0;
@@ -188,7 +189,7 @@ void rng_long_jump(void) {
    computations) or xorshift1024* (for massively parallel computations)
    generator. */
 
-static uint64_t x; /* The state can be seeded with any value. */
+static _Thread_local uint64_t x; /* The state can be seeded with any value. */
 
 uint64_t splitmix64_next() {
 	uint64_t z = (x += 0x9e3779b97f4a7c15);
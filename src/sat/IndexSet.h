@@ -0,0 +1,53 @@
+#ifndef INDEXSET_H
+#define INDEXSET_H
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Set of indices below a fixed capacity with O(1) insert, erase and
+ * access by position, which allows picking a random member
+ *
+ * Members are kept densely packed, erasing moves the last member into the
+ * freed position. Defined here to be inlined into the hot loops.
+ */
+class IndexSet {
+ private:
+  std::vector<uint32_t> members_;
+  /** Position of each index in members_, absent for non-members */
+  std::vector<uint32_t> positions_;
+  static constexpr uint32_t absent = UINT32_MAX;
+
+ public:
+  [[nodiscard]] bool contains(uint32_t index) const {
+    return positions_[index] != absent;
+  }
+  void insert(uint32_t index) {
+    assert(!contains(index));
+    positions_[index] = members_.size();
+    members_.push_back(index);
+  }
+  void erase(uint32_t index) {
+    assert(contains(index));
+    uint32_t last = members_.back();
+    members_[positions_[index]] = last;
+    positions_[last] = positions_[index];
+    positions_[index] = absent;
+    members_.pop_back();
+  }
+  void clear() {
+    for (uint32_t member : members_) positions_[member] = absent;
+    members_.clear();
+  }
+  [[nodiscard]] uint32_t size() const { return members_.size(); }
+  [[nodiscard]] bool empty() const { return members_.empty(); }
+  /** Members in no particular order */
+  [[nodiscard]] uint32_t operator[](uint32_t position) const {
+    return members_[position];
+  }
+
+  IndexSet() = default;
+  explicit IndexSet(uint32_t capacity) : positions_(capacity, absent) {}
+};
+
+#endif  // INDEXSET_H
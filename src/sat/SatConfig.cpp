@@ -1,8 +1,26 @@
 #include "SatConfig.h"
 
-#include <utility>
+SatConfig::SatConfig(uint32_t size)
+    : words_((size + 63) / 64, 0), size_(size) {}
+SatConfig::SatConfig(const std::vector<bool>& values)
+    : SatConfig(static_cast<uint32_t>(values.size())) {
+  for (uint32_t i = 0; i < values.size(); i++) set(i + 1, values[i]);
+}
 
-bool SatConfig::byId(uint32_t id) const { return underlying[id - 1]; }
-std::_Bit_reference SatConfig::byId(uint32_t id) { return underlying[id - 1]; }
-SatConfig::SatConfig(std::vector<bool>&& underlying)
-    : underlying(std::move(underlying)) {}
\ No newline at end of file
+SatConfig SatConfigBatch::extract(uint32_t lane) const {
+  SatConfig configuration(size());
+  for (uint32_t id = 1; id <= size(); id++) {
+    if ((lanes(id) >> lane) & 1) configuration.set(id, true);
+  }
+  return configuration;
+}
+void SatConfigBatch::insert(uint32_t lane, const SatConfig& configuration) {
+  uint64_t bit = uint64_t{1} << lane;
+  for (uint32_t id = 1; id <= size(); id++) {
+    if (configuration.byId(id))
+      lanes_[id - 1] |= bit;
+    else
+      lanes_[id - 1] &= ~bit;
+  }
+}
+SatConfigBatch::SatConfigBatch(uint32_t size) : lanes_(size, 0) {}
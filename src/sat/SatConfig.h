@@ -1,18 +1,73 @@
 #ifndef SATCONFIG_H
 #define SATCONFIG_H
+#include <cstdint>
+#include <span>
 #include <vector>
 
 #include "WSatInstance.h"
 
-/** Mutable */
-struct SatConfig {
-  std::vector<bool> underlying;
-  [[nodiscard]] bool byId(uint32_t id) const;
-  [[nodiscard]] std::_Bit_reference byId(uint32_t id);
+/**
+ * Mutable assignment of variables, bit-packed into 64-bit words
+ *
+ * Variable with id i is stored in bit (i - 1) % 64 of word (i - 1) / 64.
+ * Bits past size() are always zero, so words can be compared directly.
+ * Accessors are defined here to be inlined into the hot loops.
+ */
+class SatConfig {
+ private:
+  std::vector<uint64_t> words_;
+  uint32_t size_ = 0;
+
+ public:
+  [[nodiscard]] bool byId(uint32_t id) const {
+    return (words_[(id - 1) >> 6] >> ((id - 1) & 63)) & 1;
+  }
+  void set(uint32_t id, bool value) {
+    uint64_t mask = uint64_t{1} << ((id - 1) & 63);
+    if (value)
+      words_[(id - 1) >> 6] |= mask;
+    else
+      words_[(id - 1) >> 6] &= ~mask;
+  }
+  void flip(uint32_t id) {
+    words_[(id - 1) >> 6] ^= uint64_t{1} << ((id - 1) & 63);
+  }
+  /** Count of variables */
+  [[nodiscard]] uint32_t size() const { return size_; }
+  [[nodiscard]] std::span<const uint64_t> words() const { return words_; }
+  /** Caller must keep bits past size() zero */
+  [[nodiscard]] std::span<uint64_t> words() { return words_; }
+
   SatConfig() = default;
-  explicit SatConfig(std::vector<bool>&& underlying);
+  /** All variables set to false */
+  explicit SatConfig(uint32_t size);
+  explicit SatConfig(const std::vector<bool>& values);
   bool operator==(const SatConfig& other) const = default;
   bool operator!=(const SatConfig& other) const = default;
 };
 
+/**
+ * 64 assignments stored bit-sliced - the lane mask of each variable holds
+ * its value in all assignments, bit j belonging to assignment j
+ */
+class SatConfigBatch {
+ private:
+  /** Indexed by variable id - 1 */
+  std::vector<uint64_t> lanes_;
+
+ public:
+  static constexpr uint32_t width = 64;
+
+  [[nodiscard]] uint64_t lanes(uint32_t id) const { return lanes_[id - 1]; }
+  void setLanes(uint32_t id, uint64_t lanes) { lanes_[id - 1] = lanes; }
+  /** Count of variables */
+  [[nodiscard]] uint32_t size() const { return lanes_.size(); }
+  /** Assignment stored in given lane */
+  [[nodiscard]] SatConfig extract(uint32_t lane) const;
+  void insert(uint32_t lane, const SatConfig& configuration);
+
+  /** All assignments set all variables to false */
+  explicit SatConfigBatch(uint32_t size);
+};
+
 #endif  // SATCONFIG_H
@@ -1,52 +1,354 @@
 #include "SatCooling.h"
 
 #include <algorithm>
+#include <cassert>
+#include <optional>
+#include <stdexcept>
+#include <utility>
 
 #include "Rng.h"
+#include "SatEvaluation.h"
 #include "debug.h"
 
-// SatCooling
-SatConfig SatCooling::getRandomConfiguration() const {
-  Rng::next();
-  std::vector<bool> bools;
-  bools.resize(instance.variables().size());
+namespace {
+/** Terms of the clause, offsets are implied by a fixed Width other than 0 */
+template <uint32_t Width>
+std::span<const Term> termsOf(const WSatInstance& instance, uint32_t clause) {
+  if constexpr (Width == 0) {
+    std::span<const uint32_t> offsets = instance.clauseOffsets();
+    return instance.terms().subspan(
+        offsets[clause], offsets[clause + 1] - offsets[clause]
+    );
+  } else {
+    return instance.terms().subspan(clause * Width, Width);
+  }
+}
 
-  for (auto val : bools) {
-    if (Rng::next() % 2 == 0) val.flip();
+/**
+ * Whether the term of given variable, which must occur in the terms, is
+ * true when the variable has given value. Fixed Width checks all terms
+ * without branching instead of searching for the variable.
+ */
+template <uint32_t Width>
+bool isTermTrue(std::span<const Term> terms, uint32_t variableId, bool value) {
+  if constexpr (Width == 0) {
+    auto term = std::ranges::find_if(terms, [&](const Term& t) {
+      return t.id() == variableId;
+    });
+    assert(term != terms.end());
+    return term->isPlain() == value;
+  } else {
+    bool negated = false;
+    for (uint32_t i = 0; i < Width; i++) {
+      negated |= (terms[i].id() == variableId) & terms[i].isNegated();
+    }
+    return negated != value;
   }
-  return SatConfig(std::move(bools));
 }
 
-SatConfig SatCooling::getRandomNeighbor(const SatConfig& configuration) const {
-  std::vector<bool> copy = configuration.underlying;
-  copy[Rng::next() % copy.size()].flip();
-  return SatConfig(std::move(copy));
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+template <typename T>
+T readValue(std::istream& in) {
+  T value;
+  if (!in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+    throw std::invalid_argument("Checkpoint ended unexpectedly");
+  return value;
 }
+}  // namespace
 
-SatCriteria SatCooling::evaluateConfiguration(
-    const SatConfig& configuration
+// SatCooling
+SatConfig SatCooling::getRandomConfiguration(Rng& rng) const {
+  SatConfig configuration(instance->variableCount());
+  std::span<uint64_t> words = configuration.words();
+  for (uint64_t& word : words) word = rng.next();
+  // Keep bits past the last variable zero
+  if (configuration.size() % 64 != 0)
+    words.back() &= (uint64_t{1} << (configuration.size() % 64)) - 1;
+  return configuration;
+}
+
+SatConfig SatCooling::getBestRandomConfiguration(
+    uint32_t count, Rng& rng
 ) const {
-  uint32_t satisfiedClauses = 0;
-  for (const Clause& clause : instance.clauses()) {
-    for (const Term& disjunct : clause.disjuncts()) {
-      bool isSet = configuration.byId(disjunct.id());
-      if ((disjunct.isPlain() && isSet) or (disjunct.isNegated() && !isSet)) {
-        satisfiedClauses += 1;
-        break;
+  if (count <= 1) return getRandomConfiguration(rng);
+  SatConfigBatch batch(instance->variableCount());
+  std::optional<SatCriteria> bestCriteria;
+  SatConfig best;
+  for (uint32_t generated = 0; generated < count;
+       generated += SatConfigBatch::width) {
+    for (uint32_t id = 1; id <= batch.size(); id++) {
+      batch.setLanes(id, rng.next());
+    }
+    auto criteria = evaluateBatch(*instance, batch);
+    uint32_t lanes = std::min(count - generated, SatConfigBatch::width);
+    for (uint32_t lane = 0; lane < lanes; lane++) {
+      if (!bestCriteria || *bestCriteria < criteria[lane]) {
+        bestCriteria = criteria[lane];
+        best = batch.extract(lane);
       }
     }
   }
+  return best;
+}
+
+SatConfig SatCooling::getRandomNeighbor(
+    const SatConfig& configuration, Rng& rng
+) {
+  synchronize(configuration);
+  SatConfig copy = configuration;
+  proposedFlip = pickVariable(rng);
+  copy.flip(proposedFlip);
+  return copy;
+}
+
+SatCriteria SatCooling::evaluateConfiguration(const SatConfig& configuration) {
+  proposedFlip = 0;
+  return track(configuration);
+}
+
+SatCriteria SatCooling::evaluateProposed(const SatConfig& neighbor) {
+  uint32_t flip = std::exchange(proposedFlip, 0);
+  if (flip == 0) return track(neighbor);
+  assert(neighbor.size() == tracked.size());
+  assert(neighbor.byId(flip) != tracked.byId(flip));
+  scoredFlip = flip;
+  SatCriteria criteria = scoreFlip(flip);
+#ifdef DEBUG_ENABLED
+  SatCriteria full = evaluateFully(neighbor);
+  assert(full.satisfied() == criteria.satisfied());
+  assert(full.weight() == criteria.weight());
+#endif
+  return criteria;
+}
+
+SatCooling::Move SatCooling::proposeMove(
+    const SatConfig& configuration, Rng& rng
+) const {
+  assert(configuration.size() == tracked.size());
+  return pickVariable(rng);
+}
+
+SatCriteria SatCooling::evaluateMove(
+    const SatConfig& configuration, Move move
+) const {
+  assert(configuration.byId(move) == tracked.byId(move));
+  return scoreFlip(move);
+}
+
+void SatCooling::applyMove(SatConfig& configuration, Move move) {
+  configuration.flip(move);
+  applyFlip(move);
+}
+
+void SatCooling::replayMove(SatConfig& configuration, Move move) const {
+  configuration.flip(move);
+}
+
+SatCooling::FlipScore SatCooling::flipScore(
+    const SatConfig& configuration, Move move
+) const {
+  assert(configuration.byId(move) == tracked.byId(move));
+  int32_t weight = instance->weights()[move - 1];
+  return FlipScore{
+      .makeCount = makes[move - 1],
+      .breakCount = breaks[move - 1],
+      .weightDelta = tracked.byId(move) ? -weight : weight,
+  };
+}
+
+int32_t SatCooling::FlipScore::satisfiedDelta() const {
+  return static_cast<int32_t>(makeCount) - static_cast<int32_t>(breakCount);
+}
+
+SatCriteria SatCooling::evaluateFully(const SatConfig& configuration) const {
+  std::vector<uint32_t> counts;
+  return scan(configuration, counts);
+}
+
+SatCriteria SatCooling::satisfiedWithWeight(int32_t weight) const {
+  return SatCriteria(*instance, instance->clauseCount(), weight);
+}
 
-  int32_t totalWeights = 0;
-  for (uint32_t i = 0; i < configuration.underlying.size(); i++) {
-    if (configuration.underlying[i] == true) {
-      totalWeights += instance.variables().at(i).weight();
+void SatCooling::writeConfiguration(
+    std::ostream& out, const SatConfig& configuration
+) const {
+  writeValue(out, configuration.size());
+  for (uint64_t word : configuration.words()) writeValue(out, word);
+}
+
+SatConfig SatCooling::readConfiguration(std::istream& in) const {
+  if (readValue<uint32_t>(in) != instance->variableCount())
+    throw std::invalid_argument("Checkpoint has other count of variables");
+  SatConfig configuration(instance->variableCount());
+  for (uint64_t& word : configuration.words()) word = readValue<uint64_t>(in);
+  if (configuration.size() % 64 != 0 &&
+      configuration.words().back() >> (configuration.size() % 64) != 0)
+    throw std::invalid_argument("Checkpoint sets variables past the last");
+  return configuration;
+}
+
+void SatCooling::writeSearchState(std::ostream& out) const {
+  writeConfiguration(out, tracked);
+  writeValue(out, scoredFlip);
+  writeValue(out, unsatisfied.size());
+  for (uint32_t i = 0; i < unsatisfied.size(); i++)
+    writeValue(out, unsatisfied[i]);
+}
+
+void SatCooling::readSearchState(std::istream& in) {
+  track(readConfiguration(in));
+  scoredFlip = readValue<uint32_t>(in);
+  if (scoredFlip > instance->variableCount())
+    throw std::invalid_argument("Checkpoint flips unknown variable");
+  // Same clauses, but in the order the uninterrupted search had them
+  uint32_t count = readValue<uint32_t>(in);
+  if (count != unsatisfied.size())
+    throw std::invalid_argument("Checkpoint has other unsatisfied clauses");
+  std::vector<uint32_t> order(count);
+  for (uint32_t& clause : order) {
+    clause = readValue<uint32_t>(in);
+    if (clause >= instance->clauseCount() || !unsatisfied.contains(clause))
+      throw std::invalid_argument("Checkpoint has other unsatisfied clauses");
+  }
+  unsatisfied.clear();
+  for (uint32_t clause : order) {
+    if (unsatisfied.contains(clause))
+      throw std::invalid_argument("Checkpoint repeats unsatisfied clause");
+    unsatisfied.insert(clause);
+  }
+}
+
+SatCriteria SatCooling::scan(
+    const SatConfig& configuration, std::vector<uint32_t>& counts
+) const {
+  counts.resize(instance->clauseCount());
+  uint32_t satisfied = countTrueLiterals(*instance, configuration, counts);
+  return SatCriteria(
+      *instance, satisfied, sumWeights(*instance, configuration)
+  );
+}
+
+SatCriteria SatCooling::track(const SatConfig& configuration) {
+  scoredFlip = 0;
+  tracked = configuration;
+  SatCriteria criteria = scan(tracked, trueLiterals);
+  unsatisfied.clear();
+  trueVariables.assign(instance->clauseCount(), 0);
+  makes.assign(instance->variableCount(), 0);
+  breaks.assign(instance->variableCount(), 0);
+  for (uint32_t c = 0; c < instance->clauseCount(); c++) {
+    for (const Term& term : instance->clause(c).disjuncts()) {
+      if (term.isPlain() == tracked.byId(term.id()))
+        trueVariables[c] ^= term.id();
+      if (trueLiterals[c] == 0) makes[term.id() - 1]++;
+    }
+    if (trueLiterals[c] == 0) unsatisfied.insert(c);
+    if (trueLiterals[c] == 1) breaks[trueVariables[c] - 1]++;
+  }
+  trackedSatisfied = criteria.satisfied();
+  trackedWeight = criteria.weight();
+  return criteria;
+}
+
+SatCriteria SatCooling::scoreFlip(uint32_t variableId) const {
+  int32_t satisfied = static_cast<int32_t>(trackedSatisfied) +
+      static_cast<int32_t>(makes[variableId - 1]) -
+      static_cast<int32_t>(breaks[variableId - 1]);
+  int32_t weight = instance->weights()[variableId - 1];
+  weight = tracked.byId(variableId) ? trackedWeight - weight
+                                    : trackedWeight + weight;
+  return SatCriteria(*instance, satisfied, weight);
+}
+
+void SatCooling::applyFlip(uint32_t variableId) {
+  switch (instance->uniformWidth()) {
+    case 3:
+      return applyFlipOf<3>(variableId);
+    case 5:
+      return applyFlipOf<5>(variableId);
+    default:
+      return applyFlipOf<0>(variableId);
+  }
+}
+
+template <uint32_t Width>
+void SatCooling::applyFlipOf(uint32_t variableId) {
+  std::span<const uint32_t> occurrenceOffsets = instance->occurrenceOffsets();
+  std::span<const uint32_t> occurrences = instance->occurrences();
+  bool value = tracked.byId(variableId);
+  for (uint32_t o = occurrenceOffsets[variableId - 1];
+       o < occurrenceOffsets[variableId];
+       o++) {
+    uint32_t clause = occurrences[o];
+    std::span<const Term> terms = termsOf<Width>(*instance, clause);
+    if (isTermTrue<Width>(terms, variableId, value)) {
+      trueVariables[clause] ^= variableId;
+      uint32_t count = --trueLiterals[clause];
+      if (count == 0) {
+        // Flipping any of its variables satisfies the clause
+        unsatisfied.insert(clause);
+        trackedSatisfied--;
+        breaks[variableId - 1]--;
+        for (const Term& term : terms) makes[term.id() - 1]++;
+      } else if (count == 1) {
+        breaks[trueVariables[clause] - 1]++;
+      }
+    } else {
+      uint32_t count = trueLiterals[clause]++;
+      if (count == 0) {
+        unsatisfied.erase(clause);
+        trackedSatisfied++;
+        for (const Term& term : terms) makes[term.id() - 1]--;
+        breaks[variableId - 1]++;
+      } else if (count == 1) {
+        // The only true literal so far gets company
+        breaks[trueVariables[clause] - 1]--;
+      }
+      trueVariables[clause] ^= variableId;
     }
   }
-  return SatCriteria(instance, satisfiedClauses, totalWeights);
+  int32_t weight = instance->weights()[variableId - 1];
+  trackedWeight += value ? -weight : weight;
+  tracked.flip(variableId);
 }
 
+void SatCooling::synchronize(const SatConfig& configuration) {
+  if (scoredFlip != 0 &&
+      configuration.byId(scoredFlip) != tracked.byId(scoredFlip)) {
+    applyFlip(scoredFlip);
+  }
+  scoredFlip = 0;
+}
+
+uint32_t SatCooling::pickVariable(Rng& rng) const {
+  if (walkProbability > 0 && !unsatisfied.empty() &&
+      rng.nextDouble() < walkProbability) {
+    uint32_t clause = unsatisfied[rng.next() % unsatisfied.size()];
+    std::span<const uint32_t> offsets = instance->clauseOffsets();
+    uint32_t width = offsets[clause + 1] - offsets[clause];
+    // Empty clause cannot be satisfied by any flip
+    if (width > 0)
+      return instance->terms()[offsets[clause] + rng.next() % width].id();
+  }
+  return rng.next() % instance->variableCount() + 1;
+}
+
+SatCooling::SatCooling(
+    const std::vector<std::vector<int32_t>>& clauses,
+    const std::vector<int32_t>& weights,
+    double walkProbability
+)
+    : SatCooling(
+          std::make_shared<const WSatInstance>(clauses, weights),
+          walkProbability
+      ) {}
+
 SatCooling::SatCooling(
-    std::vector<std::vector<int32_t>> clauses, std::vector<int32_t> weights
+    std::shared_ptr<const WSatInstance> instance, double walkProbability
 )
-    : instance(WSatInstance(clauses, weights)) {}
+    : instance(std::move(instance)),
+      walkProbability(walkProbability),
+      unsatisfied(this->instance->clauseCount()) {}
@@ -1,22 +1,164 @@
 #pragma once
+#include <IndexSet.h>
+#include <Rng.h>
 #include <SatConfig.h>
 #include <SatCriteria.h>
 #include <WSatInstance.h>
 
+#include <istream>
+#include <memory>
+#include <ostream>
+
+/**
+ * Implements the Problemable and MoveProblemable interfaces for MWSAT
+ *
+ * Neighbors differ from their origin by a single flipped variable, which is
+ * why SatCooling tracks the last evaluated configuration: a neighbor is then
+ * scored by visiting only the clauses the flipped variable occurs in.
+ *
+ * Copies share the immutable instance, but each tracks its own state, so
+ * every copy can serve a chain on another thread.
+ */
 class SatCooling {
  private:
-  WSatInstance instance;
-  static constexpr double p = 0.4;
+  std::shared_ptr<const WSatInstance> instance;
+  /**
+   * Probability of flipping a variable of a random unsatisfied clause
+   * instead of any variable, WalkSAT style
+   */
+  double walkProbability;
+
+  /// @name Incremental evaluation
+  ///@{
+  /** Configuration the counts below belong to */
+  SatConfig tracked;
+  /** Count of true literals for each clause under tracked configuration */
+  std::vector<uint32_t> trueLiterals;
+  uint32_t trackedSatisfied = 0;
+  int32_t trackedWeight = 0;
+  /** Indices of clauses unsatisfied under tracked configuration */
+  IndexSet unsatisfied;
+  /**
+   * Xor of ids of variables with a true literal for each clause, which is
+   * the id of the only one when the clause has a single true literal
+   */
+  std::vector<uint32_t> trueVariables;
+  /** Count of unsatisfied clauses each variable occurs in, by id - 1 */
+  std::vector<uint32_t> makes;
+  /** Count of clauses each variable is the only true literal of, by id - 1 */
+  std::vector<uint32_t> breaks;
+  /** Id of variable flipped by the last getRandomNeighbor(), 0 if none */
+  uint32_t proposedFlip = 0;
+  /** Id of variable whose flip was scored, but not yet applied, 0 if none */
+  uint32_t scoredFlip = 0;
+  ///@}
+
+  /** Counts true literals of all clauses, O(clauses) */
+  [[nodiscard]] SatCriteria scan(
+      const SatConfig& configuration, std::vector<uint32_t>& counts
+  ) const;
+  /** Resets the tracked state to given configuration, O(clauses) */
+  SatCriteria track(const SatConfig& configuration);
+  /** Scores flip of given variable against tracked state, O(1) */
+  [[nodiscard]] SatCriteria scoreFlip(uint32_t variableId) const;
+  /**
+   * Applies flip of given variable to tracked state, O(occurrences) plus
+   * the width of each clause that changes between satisfied and unsatisfied
+   */
+  void applyFlip(uint32_t variableId);
+  /** Specialized by uniform clause width, 0 stands for varying widths */
+  template <uint32_t Width>
+  void applyFlipOf(uint32_t variableId);
+  /** Catches up with the flip scored last, if it got accepted since */
+  void synchronize(const SatConfig& configuration);
+  /** Id of variable to flip next, possibly from an unsatisfied clause */
+  [[nodiscard]] uint32_t pickVariable(Rng& rng) const;
 
  public:
-  [[nodiscard]] SatConfig getRandomConfiguration() const;
-  [[nodiscard]] SatConfig getRandomNeighbor(
-      const SatConfig& configuration
+  /** Id of variable to flip */
+  using Move = uint32_t;
+
+  /** How flipping a variable would change the configuration evaluated last */
+  struct FlipScore {
+    /** Unsatisfied clauses which become satisfied */
+    uint32_t makeCount;
+    /** Satisfied clauses which become unsatisfied */
+    uint32_t breakCount;
+    int32_t weightDelta;
+    [[nodiscard]] int32_t satisfiedDelta() const;
+  };
+
+  [[nodiscard]] SatConfig getRandomConfiguration(Rng& rng) const;
+  /**
+   * Best of count random configurations, which are generated and scored
+   * 64 at a time by the bit-sliced evaluator
+   */
+  [[nodiscard]] SatConfig getBestRandomConfiguration(
+      uint32_t count, Rng& rng
   ) const;
+  /**
+   * Flips a single variable of the configuration evaluated last, which
+   * evaluateProposed() then scores cheaply
+   */
+  [[nodiscard]] SatConfig getRandomNeighbor(
+      const SatConfig& configuration, Rng& rng
+  );
+  /** Scans the configuration fully and tracks it, O(clauses) */
   [[nodiscard]] SatCriteria evaluateConfiguration(
       const SatConfig& configuration
+  );
+  /**
+   * Scores the neighbor the last getRandomNeighbor() returned from the
+   * flip it made, so it must be passed unchanged and before any other
+   * evaluation, scanned fully if no neighbor was proposed since
+   *
+   * Only debug builds cross-check the score with a full scan.
+   */
+  [[nodiscard]] SatCriteria evaluateProposed(const SatConfig& neighbor);
+  /// @name Moves
+  /// Configuration passed in must be the one evaluated last with moves
+  /// applied since
+  ///@{
+  [[nodiscard]] Move proposeMove(
+      const SatConfig& configuration, Rng& rng
+  ) const;
+  [[nodiscard]] SatCriteria evaluateMove(
+      const SatConfig& configuration, Move move
   ) const;
+  void applyMove(SatConfig& configuration, Move move);
+  /** Flips the variable without touching the tracked state */
+  void replayMove(SatConfig& configuration, Move move) const;
+  /** Cached, so greedy strategies can compare all moves cheaply, O(1) */
+  [[nodiscard]] FlipScore flipScore(
+      const SatConfig& configuration, Move move
+  ) const;
+  ///@}
+  /** Full scan not touching the tracked state, meant for validation */
+  [[nodiscard]] SatCriteria evaluateFully(const SatConfig& configuration) const;
+  /** Criteria of any satisfying configuration of given weight */
+  [[nodiscard]] SatCriteria satisfiedWithWeight(int32_t weight) const;
+  /// @name Checkpoints
+  /// Binary in native byte order, reading throws std::invalid_argument on
+  /// data not matching the instance
+  ///@{
+  void writeConfiguration(
+      std::ostream& out, const SatConfig& configuration
+  ) const;
+  [[nodiscard]] SatConfig readConfiguration(std::istream& in) const;
+  /**
+   * Tracked configuration, flip scored last and the order of unsatisfied
+   * clauses, which walk moves pick from
+   */
+  void writeSearchState(std::ostream& out) const;
+  void readSearchState(std::istream& in);
+  ///@}
+  /** @param walkProbability 0 flips uniformly random variables only */
+  explicit SatCooling(
+      const std::vector<std::vector<int32_t>>& clauses,
+      const std::vector<int32_t>& weights,
+      double walkProbability = 0
+  );
   explicit SatCooling(
-      std::vector<std::vector<int32_t>> clauses, std::vector<int32_t> weights
+      std::shared_ptr<const WSatInstance> instance, double walkProbability = 0
   );
 };
@@ -7,11 +7,9 @@
 double SatCriteria::satisfiedRatio() const {
   DEBUG_PRINT(
       "Satisfied ratio:"
-      << (static_cast<double>(satisfiedCount) /
-          static_cast<double>(instance->clauses().size()))
+      << (static_cast<double>(satisfiedCount) * instance->inverseClauseCount())
   )
-  return static_cast<double>(satisfiedCount) /
-      static_cast<double>(instance->clauses().size());
+  return static_cast<double>(satisfiedCount) * instance->inverseClauseCount();
 }
 
 SatCriteria::SatCriteria(
@@ -21,15 +19,14 @@ SatCriteria::SatCriteria(
 
 int32_t SatCriteria::weight() const { return weights; }
 double SatCriteria::normalizedWeight() const {
-  return static_cast<double>(weights) /
-      static_cast<double>(instance->weightTotal());
+  return static_cast<double>(weights) * instance->inverseWeightTotal();
 }
 uint32_t SatCriteria::satisfied() const { return satisfiedCount; }
 
 bool SatCriteria::isValid() const { return isSatisfied(); }
 
 bool SatCriteria::isSatisfied() const {
-  return satisfiedCount == instance->clauses().size();
+  return satisfiedCount == instance->clauseCount();
 }
 
 bool SatCriteria::operator<(const SatCriteria& other) const {
@@ -43,24 +40,14 @@ bool SatCriteria::operator>=(const SatCriteria& other) const {
 
 // We need to know how worse we are => him - us
 double SatCriteria::howMuchWorseThan(const SatCriteria& other) const {
-  // Both formulas satisfied => compare weights
-  if (this->isSatisfied() and other.isSatisfied())
-    return other.normalizedWeight() - this->normalizedWeight();
-
-  // Neither formulas satisfied => compare satisfied
-  if (not this->isSatisfied() and not other.isSatisfied())
-    return other.satisfiedRatio() - this->satisfiedRatio();
-
-  // We are satisfied, but he is not => penalize him
-  if (this->isSatisfied() and not other.isSatisfied()) {
-    return other.normalizedWeight() * other.satisfiedRatio() -
-        this->normalizedWeight();
-  }
-
-  // We are not satisfied, but he is => penalize ourselves
-  // if (not this->isSatisfied() and other.isSatisfied())
-  return other.normalizedWeight() -
-      this->normalizedWeight() * this->satisfiedRatio();
+  return howMuchWorse(
+      isSatisfied(),
+      satisfiedRatio(),
+      normalizedWeight(),
+      other.isSatisfied(),
+      other.satisfiedRatio(),
+      other.normalizedWeight()
+  );
 }
 
 std::ostream& operator<<(std::ostream& os, const SatCriteria& criteria) {
@@ -35,6 +35,26 @@ class SatCriteria {
   bool operator<(const SatCriteria& other) const;
   bool operator>=(const SatCriteria& other) const;
   [[nodiscard]] double howMuchWorseThan(const SatCriteria& other) const;
+  /**
+   * howMuchWorseThan() of plain satisfied ratios and normalized weights,
+   * inline and branchless, so loops over many candidates vectorize
+   */
+  [[nodiscard]] static double howMuchWorse(
+      bool satisfied,
+      double ratio,
+      double weight,
+      bool otherSatisfied,
+      double otherRatio,
+      double otherWeight
+  ) {
+    // Both satisfied => compare weights, neither => compare satisfied
+    // ratios, only one => penalize the weight of the other one by its ratio
+    double score = satisfied ? weight : otherSatisfied ? weight * ratio : ratio;
+    double otherScore = otherSatisfied ? otherWeight
+        : satisfied                    ? otherWeight * otherRatio
+                                       : otherRatio;
+    return otherScore - score;
+  }
 };
 
 #endif  // SATCRITERIA_H
@@ -0,0 +1,267 @@
+#include "SatEvaluation.h"
+
+#include <bit>
+#include <type_traits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SAT_EVALUATION_AVX2
+#include <immintrin.h>
+#endif
+
+// Kernels read terms as raw int32_t
+static_assert(sizeof(Term) == sizeof(int32_t));
+static_assert(std::is_standard_layout_v<Term>);
+
+namespace {
+// ===================== Scalar =====================
+
+/** Counts true literals of clauses starting with the given one */
+uint32_t scalarCountTrueLiterals(
+    const WSatInstance& instance,
+    const SatConfig& configuration,
+    std::span<uint32_t> counts,
+    uint32_t firstClause
+) {
+  std::span<const Term> terms = instance.terms();
+  std::span<const uint32_t> offsets = instance.clauseOffsets();
+  uint32_t satisfied = 0;
+  for (uint32_t c = firstClause; c < instance.clauseCount(); c++) {
+    uint32_t count = 0;
+    for (uint32_t t = offsets[c]; t < offsets[c + 1]; t++) {
+      count += terms[t].isPlain() == configuration.byId(terms[t].id());
+    }
+    counts[c] = count;
+    satisfied += count > 0;
+  }
+  return satisfied;
+}
+
+/** Same as above for clauses of fixed Width, offsets are implied */
+template <uint32_t Width>
+uint32_t scalarCountTrueLiteralsFixed(
+    const WSatInstance& instance,
+    const SatConfig& configuration,
+    std::span<uint32_t> counts,
+    uint32_t firstClause
+) {
+  const Term* terms = instance.terms().data();
+  uint32_t satisfied = 0;
+  for (uint32_t c = firstClause; c < instance.clauseCount(); c++) {
+    const Term* clause = terms + c * Width;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < Width; i++) {
+      count += clause[i].isPlain() == configuration.byId(clause[i].id());
+    }
+    counts[c] = count;
+    satisfied += count > 0;
+  }
+  return satisfied;
+}
+
+/** Sums weights of variables starting with the given index */
+int32_t scalarSumWeights(
+    const WSatInstance& instance,
+    const SatConfig& configuration,
+    uint32_t firstIndex
+) {
+  std::span<const int32_t> weights = instance.weights();
+  std::span<const uint64_t> words = configuration.words();
+  int32_t sum = 0;
+  for (uint32_t w = firstIndex / 64; w < words.size(); w++) {
+    // Bits past size() are zero, so only the first word needs masking
+    uint64_t word = words[w];
+    if (w == firstIndex / 64) word &= ~uint64_t{0} << (firstIndex % 64);
+    while (word != 0) {
+      sum += weights[w * 64 + std::countr_zero(word)];
+      word &= word - 1;
+    }
+  }
+  return sum;
+}
+// ===================== EndScalar =====================
+
+#ifdef SAT_EVALUATION_AVX2
+// ===================== Avx2 =====================
+
+/**
+ * Evaluates 8 clauses at once, lane j walks terms of clause c + j and
+ * gathers the bit of each term's variable. Offsets must fit into int32_t.
+ */
+__attribute__((target("avx2"))) uint32_t avx2CountTrueLiterals(
+    const WSatInstance& instance,
+    const SatConfig& configuration,
+    std::span<uint32_t> counts
+) {
+  const auto* terms = reinterpret_cast<const int*>(instance.terms().data());
+  const auto* words =
+      reinterpret_cast<const int*>(configuration.words().data());
+  const uint32_t* offsets = instance.clauseOffsets().data();
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i low5 = _mm256_set1_epi32(31);
+
+  uint32_t satisfied = 0;
+  uint32_t c = 0;
+  for (; c + 8 <= instance.clauseCount(); c += 8) {
+    __m256i position =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + c));
+    __m256i end = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(offsets + c + 1)
+    );
+    __m256i count = zero;
+    __m256i active = _mm256_cmpgt_epi32(end, position);
+    while (!_mm256_testz_si256(active, active)) {
+      __m256i term =
+          _mm256_mask_i32gather_epi32(zero, terms, position, active, 4);
+      __m256i index = _mm256_sub_epi32(_mm256_abs_epi32(term), one);
+      __m256i word = _mm256_mask_i32gather_epi32(
+          zero, words, _mm256_srli_epi32(index, 5), active, 4
+      );
+      __m256i bit = _mm256_and_si256(
+          _mm256_srlv_epi32(word, _mm256_and_si256(index, low5)), one
+      );
+      // Negated term is true when its bit is zero
+      __m256i isTrue = _mm256_xor_si256(bit, _mm256_srli_epi32(term, 31));
+      count = _mm256_add_epi32(count, _mm256_and_si256(isTrue, active));
+      position = _mm256_add_epi32(position, one);
+      active = _mm256_cmpgt_epi32(end, position);
+    }
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(counts.data() + c), count
+    );
+    int unsatisfied = _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(count, zero))
+    );
+    satisfied += 8 - std::popcount(static_cast<uint32_t>(unsatisfied));
+  }
+  return satisfied +
+      scalarCountTrueLiterals(instance, configuration, counts, c);
+}
+
+/** Expands each byte of the configuration into a mask over 8 weights */
+__attribute__((target("avx2"))) int32_t avx2SumWeights(
+    const WSatInstance& instance, const SatConfig& configuration
+) {
+  const int32_t* weights = instance.weights().data();
+  std::span<const uint64_t> words = configuration.words();
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+  __m256i sum = zero;
+  uint32_t v = 0;
+  for (; v + 8 <= configuration.size(); v += 8) {
+    auto byte = static_cast<int>((words[v / 64] >> (v % 64)) & 0xFF);
+    __m256i bits = _mm256_and_si256(
+        _mm256_srlv_epi32(_mm256_set1_epi32(byte), lanes), one
+    );
+    __m256i selected = _mm256_and_si256(
+        _mm256_sub_epi32(zero, bits),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + v))
+    );
+    sum = _mm256_add_epi32(sum, selected);
+  }
+  __m128i half = _mm_add_epi32(
+      _mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)
+  );
+  half = _mm_hadd_epi32(half, half);
+  half = _mm_hadd_epi32(half, half);
+  return _mm_cvtsi128_si32(half) +
+      scalarSumWeights(instance, configuration, v);
+}
+// ===================== EndAvx2 =====================
+#endif
+}  // namespace
+
+EvaluationKernel availableKernel() {
+#ifdef SAT_EVALUATION_AVX2
+  static const EvaluationKernel kernel = __builtin_cpu_supports("avx2")
+      ? EvaluationKernel::Avx2
+      : EvaluationKernel::Scalar;
+  return kernel;
+#else
+  return EvaluationKernel::Scalar;
+#endif
+}
+
+uint32_t countTrueLiterals(
+    const WSatInstance& instance,
+    const SatConfig& configuration,
+    std::span<uint32_t> counts,
+    EvaluationKernel kernel
+) {
+#ifdef SAT_EVALUATION_AVX2
+  // Gathering configuration words dominates, so fixed width does not pay
+  // off for the AVX2 kernel
+  if (kernel == EvaluationKernel::Avx2 &&
+      availableKernel() == EvaluationKernel::Avx2)
+    return avx2CountTrueLiterals(instance, configuration, counts);
+#endif
+  switch (instance.uniformWidth()) {
+    case 3:
+      return scalarCountTrueLiteralsFixed<3>(
+          instance, configuration, counts, 0
+      );
+    case 5:
+      return scalarCountTrueLiteralsFixed<5>(
+          instance, configuration, counts, 0
+      );
+    default:
+      return scalarCountTrueLiterals(instance, configuration, counts, 0);
+  }
+}
+
+int32_t sumWeights(
+    const WSatInstance& instance,
+    const SatConfig& configuration,
+    EvaluationKernel kernel
+) {
+#ifdef SAT_EVALUATION_AVX2
+  if (kernel == EvaluationKernel::Avx2 &&
+      availableKernel() == EvaluationKernel::Avx2)
+    return avx2SumWeights(instance, configuration);
+#endif
+  return scalarSumWeights(instance, configuration, 0);
+}
+
+std::array<SatCriteria, SatConfigBatch::width> evaluateBatch(
+    const WSatInstance& instance, const SatConfigBatch& batch
+) {
+  std::span<const Term> terms = instance.terms();
+  std::span<const uint32_t> offsets = instance.clauseOffsets();
+
+  // Bit-sliced counters of satisfied clauses, plane p holds bit p of the
+  // count of every lane, so adding a mask ripples a carry through planes
+  std::array<uint64_t, 32> planes{};
+  for (uint32_t c = 0; c < instance.clauseCount(); c++) {
+    uint64_t satisfied = 0;
+    for (uint32_t t = offsets[c]; t < offsets[c + 1]; t++) {
+      uint64_t lanes = batch.lanes(terms[t].id());
+      satisfied |= terms[t].isPlain() ? lanes : ~lanes;
+    }
+    for (uint64_t& plane : planes) {
+      uint64_t carry = plane & satisfied;
+      plane ^= satisfied;
+      satisfied = carry;
+      if (satisfied == 0) break;
+    }
+  }
+
+  std::array<int32_t, SatConfigBatch::width> weights{};
+  std::span<const int32_t> variableWeights = instance.weights();
+  for (uint32_t id = 1; id <= batch.size(); id++) {
+    for (uint64_t lanes = batch.lanes(id); lanes != 0; lanes &= lanes - 1) {
+      weights[std::countr_zero(lanes)] += variableWeights[id - 1];
+    }
+  }
+
+  std::array<SatCriteria, SatConfigBatch::width> criteria;
+  for (uint32_t lane = 0; lane < SatConfigBatch::width; lane++) {
+    uint32_t satisfied = 0;
+    for (uint32_t p = 0; p < planes.size(); p++) {
+      satisfied |= static_cast<uint32_t>((planes[p] >> lane) & 1) << p;
+    }
+    criteria[lane] = SatCriteria(instance, satisfied, weights[lane]);
+  }
+  return criteria;
+}
@@ -0,0 +1,50 @@
+#ifndef SATEVALUATION_H
+#define SATEVALUATION_H
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "SatConfig.h"
+#include "SatCriteria.h"
+#include "WSatInstance.h"
+
+/**
+ * Kernels evaluating the whole formula at once
+ *
+ * Used whenever the incremental state cannot be relied upon - on the first
+ * evaluation, restarts and validation. The kernel is chosen at runtime by
+ * the features of the running CPU.
+ */
+enum class EvaluationKernel { Scalar, Avx2 };
+
+/** Fastest kernel the running CPU supports, detected once */
+[[nodiscard]] EvaluationKernel availableKernel();
+
+/**
+ * Counts true literals of every clause into counts
+ * @param counts must hold instance.clauseCount() elements
+ * @return count of satisfied clauses
+ */
+uint32_t countTrueLiterals(
+    const WSatInstance& instance,
+    const SatConfig& configuration,
+    std::span<uint32_t> counts,
+    EvaluationKernel kernel = availableKernel()
+);
+
+/** Sum of weights of variables set to true */
+[[nodiscard]] int32_t sumWeights(
+    const WSatInstance& instance,
+    const SatConfig& configuration,
+    EvaluationKernel kernel = availableKernel()
+);
+
+/**
+ * Evaluates all 64 assignments of the batch in a single pass over the
+ * clauses, each clause costs a few word operations for all of them
+ */
+[[nodiscard]] std::array<SatCriteria, SatConfigBatch::width> evaluateBatch(
+    const WSatInstance& instance, const SatConfigBatch& batch
+);
+
+#endif  // SATEVALUATION_H
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "CoolingSchedule.h"
+#include "MoveJournal.h"
+#include "Rng.h"
+#include "RngLanes.h"
+#include "SatConfig.h"
+#include "SatCooling.h"
+#include "SatCriteria.h"
+#include "WSatInstance.h"
+
+/**
+ * Lanes independent annealing chains over one shared instance, advanced in
+ * lockstep on a single thread
+ *
+ * Random numbers, picking of variables, scoring of flips and acceptance
+ * decisions run for all lanes at once on structure of arrays state, in
+ * loops the compiler vectorizes. Only looking up the cached flip scores and
+ * applying accepted flips goes lane by lane, through a SatCooling each.
+ *
+ * Lanes flip uniformly random variables, like SatCooling without walk
+ * probability, and cool geometrically by the shared schedule, each from its
+ * own start temperature. A lane stops on its own once frozen, the others
+ * carry on.
+ */
+template <uint32_t Lanes>
+class SatLockstep {
+ public:
+  template <typename T>
+  using PerLane = std::array<T, Lanes>;
+
+  /** Read access to one lane, named like the Cooling accessors */
+  class Lane {
+   private:
+    const SatLockstep* engine;
+    uint32_t k;
+
+   public:
+    Lane(const SatLockstep& engine, uint32_t k) : engine(&engine), k(k) {}
+    [[nodiscard]] const SatConfig& getCurrentConfiguration() const {
+      return engine->current[k];
+    }
+    [[nodiscard]] const SatConfig& getBestConfiguration() const {
+      engine->materializeBest(k);
+      return engine->best[k];
+    }
+    [[nodiscard]] SatConfig copyBestConfiguration() const {
+      return getBestConfiguration();
+    }
+    [[nodiscard]] const SatCriteria& getBestCriteria() const {
+      return engine->bestCriteria[k];
+    }
+    [[nodiscard]] uint32_t getStepsTotal() const { return engine->steps[k]; }
+    [[nodiscard]] uint32_t getStepsSinceChange() const {
+      return engine->sinceChange[k];
+    }
+    [[nodiscard]] uint32_t getStepsSinceBetterment() const {
+      return engine->sinceBetterment[k];
+    }
+    [[nodiscard]] double getTemperature() const {
+      return engine->temperature[k];
+    }
+    [[nodiscard]] std::string endedBecause() const {
+      return engine->ended[k];
+    }
+  };
+
+ private:
+  std::shared_ptr<const WSatInstance> instance;
+  CoolingSchedule schedule;
+  std::vector<SatCooling> problems;
+
+  /// @name Per lane search state
+  ///@{
+  PerLane<SatConfig> current;
+  PerLane<int32_t> currentSatisfied;
+  PerLane<int32_t> currentWeight;
+  /** Snapshots the journals replay on, as in Cooling */
+  mutable PerLane<SatConfig> best;
+  mutable PerLane<MoveJournal<SatCooling::Move>> journals;
+  PerLane<SatCriteria> bestCriteria;
+  PerLane<double> temperature;
+  PerLane<double> inverseTemperature;
+  PerLane<uint32_t> steps{};
+  PerLane<uint32_t> sinceChange{};
+  PerLane<uint32_t> sinceBetterment{};
+  /** 1 while the lane searches, kept numeric to mask the lockstep loops */
+  PerLane<uint32_t> active{};
+  PerLane<const char*> ended{};
+  ///@}
+
+  uint32_t activeCount = 0;
+  uint32_t stepsTotal = 0;
+  uint32_t stepsInEquilibrium = 0;
+  /** Declared last, creating it picks the start configurations */
+  RngLanes<Lanes> rng;
+
+  /** Splits streams by jumps, draws lane starts and tracks them */
+  RngLanes<Lanes> start(Rng stream, uint32_t randomStarts) {
+    std::vector<Rng> streams;
+    for (uint32_t k = 0; k < Lanes; k++) {
+      streams.push_back(stream);
+      current[k] =
+          problems[k].getBestRandomConfiguration(randomStarts, streams[k]);
+      best[k] = current[k];
+      bestCriteria[k] = problems[k].evaluateConfiguration(current[k]);
+      currentSatisfied[k] = static_cast<int32_t>(bestCriteria[k].satisfied());
+      currentWeight[k] = bestCriteria[k].weight();
+      stream.jump();
+    }
+    return RngLanes<Lanes>(std::span<const Rng, Lanes>(streams));
+  }
+
+  void stop(uint32_t k, const char* reason) {
+    if (!active[k]) return;
+    active[k] = 0;
+    ended[k] = reason;
+    activeCount--;
+  }
+
+  void cool() {
+    for (uint32_t k = 0; k < Lanes; k++) {
+      temperature[k] *= schedule.coolingFactor;
+      inverseTemperature[k] = 1 / temperature[k];
+      if (temperature[k] <= schedule.stopTemperature) stop(k, "temperature");
+    }
+    stepsInEquilibrium = 0;
+  }
+
+  void materializeBest(uint32_t k) const {
+    journals[k].materialize([this, k](SatCooling::Move move) {
+      problems[k].replayMove(best[k], move);
+    });
+  }
+
+  /** Flips the variable in the lane and records the new best, if it is */
+  void accept(uint32_t k, SatCooling::Move move) {
+    problems[k].applyMove(current[k], move);
+    // Bounded as in Cooling
+    MoveJournal<SatCooling::Move>& journal = journals[k];
+    journal.record(move);
+    if (journal.size() > journal.limit) {
+      materializeBest(k);
+      if (journal.size() > journal.limit / 2) journal.stop();
+    }
+
+    sinceChange[k] = 0;
+    SatCriteria criteria(
+        *instance,
+        static_cast<uint32_t>(currentSatisfied[k]),
+        currentWeight[k]
+    );
+    if (bestCriteria[k].howMuchWorseThan(criteria) <= 0 || !criteria.isValid())
+      return;
+    if (journal.isActive()) {
+      journal.markBest();
+    } else {
+      best[k] = current[k];
+      journal.restart();
+    }
+    bestCriteria[k] = criteria;
+    sinceBetterment[k] = 0;
+  }
+
+  /** Does one step in every lane still searching */
+  void step() {
+    PerLane<uint32_t> picks;
+    rng.nextBelow(instance->variableCount(), picks);
+    PerLane<int32_t> satisfiedDelta{};
+    PerLane<int32_t> weightDelta{};
+    for (uint32_t k = 0; k < Lanes; k++) {
+      if (!active[k]) continue;
+      SatCooling::FlipScore score =
+          problems[k].flipScore(current[k], picks[k] + 1);
+      satisfiedDelta[k] = score.satisfiedDelta();
+      weightDelta[k] = score.weightDelta;
+    }
+    PerLane<double> samples;
+    rng.nextExponential(samples);
+
+    // Unlike Cooling, samples are drawn even for betterments, which keeps
+    // the decision branchless
+    auto clauseCount = static_cast<int32_t>(instance->clauseCount());
+    double inverseClauseCount = instance->inverseClauseCount();
+    double inverseWeightTotal = instance->inverseWeightTotal();
+    PerLane<uint32_t> accepted;
+    for (uint32_t k = 0; k < Lanes; k++) {
+      int32_t satisfied = currentSatisfied[k] + satisfiedDelta[k];
+      int32_t weight = currentWeight[k] + weightDelta[k];
+      double worse = SatCriteria::howMuchWorse(
+          satisfied == clauseCount,
+          satisfied * inverseClauseCount,
+          weight * inverseWeightTotal,
+          currentSatisfied[k] == clauseCount,
+          currentSatisfied[k] * inverseClauseCount,
+          currentWeight[k] * inverseWeightTotal
+      );
+      uint32_t decision =
+          (worse <= 0) | (worse * inverseTemperature[k] < samples[k]);
+      accepted[k] = active[k] & decision;
+      currentSatisfied[k] = accepted[k] ? satisfied : currentSatisfied[k];
+      currentWeight[k] = accepted[k] ? weight : currentWeight[k];
+      steps[k] += active[k];
+      sinceChange[k] += active[k];
+      sinceBetterment[k] += active[k];
+    }
+
+    for (uint32_t k = 0; k < Lanes; k++) {
+      if (accepted[k]) accept(k, picks[k] + 1);
+    }
+    for (uint32_t k = 0; k < Lanes; k++) {
+      if (sinceChange[k] >= schedule.stopAfterNoChange) stop(k, "change");
+      if (sinceBetterment[k] >= schedule.stopAfterNoBetterment)
+        stop(k, "gain");
+    }
+  }
+
+ public:
+  /**
+   * Lane k draws from rng jumped k times, starts from the best of
+   * randomStarts random configurations and at startTemperature *
+   * temperatureSpread^k
+   */
+  SatLockstep(
+      std::shared_ptr<const WSatInstance> instance,
+      const CoolingSchedule& schedule,
+      Rng rng,
+      uint32_t randomStarts = 1,
+      double temperatureSpread = 1
+  )
+      : instance(std::move(instance)),
+        schedule(schedule),
+        problems(Lanes, SatCooling(this->instance)),
+        rng(start(rng, randomStarts)) {
+    double laneTemperature = schedule.startTemperature;
+    for (uint32_t k = 0; k < Lanes; k++) {
+      temperature[k] = laneTemperature;
+      inverseTemperature[k] = 1 / laneTemperature;
+      laneTemperature *= temperatureSpread;
+      active[k] = 1;
+      ended[k] = "unknown";
+    }
+    activeCount = Lanes;
+    for (uint32_t k = 0; k < Lanes; k++) {
+      if (temperature[k] <= schedule.stopTemperature) stop(k, "temperature");
+    }
+  }
+
+  /** Steps all lanes until every one of them is frozen */
+  void simulateCooling() {
+    while (activeCount > 0) {
+      if (stepsTotal >= schedule.stopAfterTotalSteps) {
+        for (uint32_t k = 0; k < Lanes; k++) stop(k, "max");
+        break;
+      }
+      if (stepsInEquilibrium >= schedule.equilibrium) {
+        cool();
+        continue;
+      }
+      uint32_t batch = std::min(
+          schedule.equilibrium - stepsInEquilibrium,
+          schedule.stopAfterTotalSteps - stepsTotal
+      );
+      uint32_t done = 0;
+      while (done < batch && activeCount > 0) {
+        step();
+        done++;
+      }
+      stepsTotal += done;
+      stepsInEquilibrium += done;
+    }
+  }
+
+  [[nodiscard]] static constexpr uint32_t size() { return Lanes; }
+  [[nodiscard]] Lane lane(uint32_t k) const { return Lane(*this, k); }
+  /** Index of lane with the best criteria, the lowest one on ties */
+  [[nodiscard]] uint32_t bestLane() const {
+    uint32_t bestK = 0;
+    for (uint32_t k = 1; k < Lanes; k++) {
+      if (bestCriteria[bestK] < bestCriteria[k]) bestK = k;
+    }
+    return bestK;
+  }
+};
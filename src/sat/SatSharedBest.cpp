@@ -0,0 +1,59 @@
+#include "SatSharedBest.h"
+
+#include <span>
+
+SatSharedBest::SatSharedBest(uint32_t variableCount) : stored(variableCount) {}
+
+uint64_t SatSharedBest::rank(const SatCriteria& criteria) {
+  // Sign flipped, so weights order as unsigned
+  auto weight = static_cast<uint32_t>(criteria.weight()) ^ 0x80000000u;
+  return (static_cast<uint64_t>(criteria.satisfied()) << 32) | weight;
+}
+
+bool SatSharedBest::publish(
+    const SatCriteria& criteria, const SatConfig& configuration
+) {
+  uint64_t rank = SatSharedBest::rank(criteria);
+  uint64_t seen = bestRank.load(std::memory_order_relaxed);
+  do {
+    if (rank <= seen) return false;
+  } while (!bestRank.compare_exchange_weak(
+      seen, rank, std::memory_order_relaxed
+  ));
+
+  while (writing.test_and_set(std::memory_order_acquire)) {
+  }
+  // A better one may have been published meanwhile, this one is stale then
+  if (bestRank.load(std::memory_order_relaxed) == rank) {
+    sequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::span<uint64_t> words = stored.words();
+    std::span<const uint64_t> source = configuration.words();
+    for (size_t i = 0; i < words.size(); i++)
+      std::atomic_ref(words[i]).store(source[i], std::memory_order_relaxed);
+    storedRank.store(rank, std::memory_order_relaxed);
+    sequence.fetch_add(1, std::memory_order_release);
+  }
+  writing.clear(std::memory_order_release);
+  return true;
+}
+
+std::optional<SatConfig> SatSharedBest::read() const {
+  SatConfig copy(stored.size());
+  std::span<uint64_t> words = copy.words();
+  // Stored words are never written but through std::atomic_ref
+  std::span<uint64_t> source(
+      const_cast<uint64_t*>(stored.words().data()), stored.words().size()
+  );
+  while (true) {
+    uint32_t before = sequence.load(std::memory_order_acquire);
+    if (before % 2 != 0) continue;
+    for (size_t i = 0; i < words.size(); i++)
+      words[i] = std::atomic_ref(source[i]).load(std::memory_order_relaxed);
+    uint64_t rank = storedRank.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence.load(std::memory_order_relaxed) != before) continue;
+    if (rank == 0) return std::nullopt;
+    return copy;
+  }
+}
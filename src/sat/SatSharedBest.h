@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+#include "SatConfig.h"
+#include "SatCriteria.h"
+
+/**
+ * Best configuration shared by cooperating chains on threads
+ *
+ * Configurations are ranked by a single 64-bit key, so publishing compares
+ * and swaps the key without any lock and gives up at once when not better.
+ * Only a publisher which won the key writes its configuration, under a
+ * seqlock: readers copy the words optimistically and retry if a write
+ * overlapped. Writers are serialized by a spin lock, publishing is rare.
+ */
+class SatSharedBest {
+ private:
+  /** Best rank published, 0 while empty */
+  std::atomic<uint64_t> bestRank{0};
+  /** Odd while the configuration is written */
+  std::atomic<uint32_t> sequence{0};
+  std::atomic_flag writing;
+  /** Rank of the configuration stored, lags bestRank while it is written */
+  std::atomic<uint64_t> storedRank{0};
+  /** Words are only accessed through std::atomic_ref */
+  SatConfig stored;
+
+ public:
+  /** Empty slot for configurations of given count of variables */
+  explicit SatSharedBest(uint32_t variableCount);
+  SatSharedBest(const SatSharedBest&) = delete;
+  SatSharedBest& operator=(const SatSharedBest&) = delete;
+
+  /**
+   * Key ordered lexicographically, by satisfied count and then by weight,
+   * never 0 for nonnegative weights
+   *
+   * Unlike SatCriteria, which weighs satisfied ratio against weight when
+   * only one side is satisfied, so any satisfied configuration outranks
+   * every unsatisfied one. Chains publish and restart by this order.
+   */
+  [[nodiscard]] static uint64_t rank(const SatCriteria& criteria);
+
+  /**
+   * Stores configuration unless one at least as good was published
+   *
+   * @return true if it was the best published so far
+   */
+  bool publish(const SatCriteria& criteria, const SatConfig& configuration);
+  /** Rank of the best published, 0 if none, one atomic load */
+  [[nodiscard]] uint64_t bestPublishedRank() const {
+    return bestRank.load(std::memory_order_relaxed);
+  }
+  /** Consistent copy of the best stored, nullopt if none */
+  [[nodiscard]] std::optional<SatConfig> read() const;
+};
+
+/**
+ * Runs the chain until its search is over, publishing to shared after an
+ * equilibrium whenever the chain ranks above the shared configuration, and
+ * every restartEvery equilibria, if not 0, continuing from the shared
+ * configuration if it ranks above the chain
+ *
+ * Chains publish their best configuration, or the current one while none
+ * is valid, so unsatisfied chains cooperate too.
+ */
+template <typename Chain>
+void runCooperating(
+    Chain& chain, SatSharedBest& shared, uint32_t restartEvery
+) {
+  // @return rank of the chain
+  auto share = [&] {
+    bool valid = chain.getBestCriteria().isValid();
+    const SatCriteria& criteria =
+        valid ? chain.getBestCriteria() : chain.getCurrentCriteria();
+    uint64_t rank = SatSharedBest::rank(criteria);
+    // Checked before publishing, which copies the best configuration
+    if (rank > shared.bestPublishedRank()) {
+      shared.publish(
+          criteria,
+          valid ? chain.getBestConfiguration()
+                : chain.getCurrentConfiguration()
+      );
+    }
+    return rank;
+  };
+
+  uint32_t equilibria = 0;
+  while (chain.runEquilibrium()) {
+    uint64_t rank = share();
+    equilibria++;
+    if (restartEvery == 0 || equilibria % restartEvery != 0) continue;
+    if (shared.bestPublishedRank() <= rank) continue;
+    if (std::optional<SatConfig> best = shared.read()) chain.moveTo(*best);
+  }
+  share();
+}
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <numeric>
 #include <ranges>
+#include <stdexcept>
+#include <string>
 
 // ===================== Term =====================
 Term::Term(int32_t underlying) : underlying(underlying) {}
@@ -14,18 +16,8 @@ bool Term::isPlain() const { return underlying > 0; }
 // ===================== EndTerm =====================
 
 // ===================== Clause =====================
-Clause::Clause(std::vector<Term>&& disjuncts)
-    : disjuncts_(std::move(disjuncts)) {
-  std::ranges::sort(disjuncts_, [](const Term& t1, const Term& t2) {
-    return t1.id() < t2.id();
-  });
-  auto duplicates =
-      std::ranges::unique(disjuncts_, [](const Term& t1, const Term& t2) {
-        return t1.id() == t2.id();
-      });
-  disjuncts_.erase(duplicates.begin(), duplicates.end());
-}
-const std::vector<Term>& Clause::disjuncts() const { return disjuncts_; }
+Clause::Clause(std::span<const Term> disjuncts) : disjuncts_(disjuncts) {}
+std::span<const Term> Clause::disjuncts() const { return disjuncts_; }
 
 // Could be made faster, but will be called only once, so no big deal
 bool Clause::isSatisfiable() const {
@@ -51,62 +43,192 @@ bool Clause::containsVariable(uint32_t variableId) const {
 
 uint32_t Variable::id() const { return id_; }
 int32_t Variable::weight() const { return weight_; }
-const std::vector<const Clause*>& Variable::occurences() const {
-  return occurrences_;
-}
+std::span<const uint32_t> Variable::occurences() const { return occurrences_; }
 
 Variable::Variable(
-    uint32_t id, int32_t weight, const std::vector<Clause>& allClauses
+    uint32_t id, int32_t weight, std::span<const uint32_t> occurrences
 )
-    : id_(id), weight_(weight) {
-  for (const Clause& clause : allClauses) {
-    if (clause.containsVariable(id)) occurrences_.push_back(&clause);
-  }
-}
+    : id_(id), weight_(weight), occurrences_(occurrences) {}
 // ===================== EndVariable =====================
 
 // ===================== Instance =====================
 
-const std::vector<Variable>& WSatInstance::variables() const {
-  return variables_;
+uint32_t WSatInstance::clauseCount() const {
+  return clauseOffsets_.size() - 1;
 }
-const std::vector<Clause>& WSatInstance::clauses() const { return clauses_; }
+uint32_t WSatInstance::variableCount() const { return weights_.size(); }
+
+Clause WSatInstance::clause(uint32_t index) const {
+  return Clause(
+      std::span(terms_).subspan(
+          clauseOffsets_[index],
+          clauseOffsets_[index + 1] - clauseOffsets_[index]
+      )
+  );
+}
+Variable WSatInstance::variable(uint32_t index) const {
+  return Variable(
+      index + 1,
+      weights_[index],
+      std::span(occurrences_)
+          .subspan(
+              occurrenceOffsets_[index],
+              occurrenceOffsets_[index + 1] - occurrenceOffsets_[index]
+          )
+  );
+}
+
+std::span<const Term> WSatInstance::terms() const { return terms_; }
+std::span<const uint32_t> WSatInstance::clauseOffsets() const {
+  return clauseOffsets_;
+}
+std::span<const uint32_t> WSatInstance::occurrences() const {
+  return occurrences_;
+}
+std::span<const uint32_t> WSatInstance::occurrenceOffsets() const {
+  return occurrenceOffsets_;
+}
+std::span<const int32_t> WSatInstance::weights() const { return weights_; }
 
-// This work could be extracted into smaller functions for reuse
 WSatInstance::WSatInstance(
-    std::vector<std::vector<int32_t>>& clauses, std::vector<int32_t>& weights
-) {
-  assert(!clauses.empty());
-  assert(!weights.empty());
-  clauses_.reserve(clauses.size());
-  // Initialize clauses
-  for (const std::vector<int32_t>& clause : clauses) {
-    // Initialize each Term in clause
-    std::vector<Term> terms = std::vector<Term>();
-    terms.reserve(clause.size());
-    for (int32_t term : clause) {
-      terms.emplace_back(term);
+    const std::vector<std::vector<int32_t>>& clauses,
+    const std::vector<int32_t>& weights
+)
+    : WSatInstance([&] {
+        Builder builder;
+        builder.problem(weights.size(), clauses.size());
+        uint64_t termCount = 0;
+        for (const std::vector<int32_t>& clause : clauses)
+          termCount += clause.size();
+        builder.terms_.reserve(termCount);
+        builder.weights(weights);
+        for (const std::vector<int32_t>& clause : clauses)
+          builder.clause(clause);
+        return builder;
+      }()) {}
+
+namespace {
+/** Storage of an instance built from clauses */
+struct BuiltArrays {
+  std::vector<Term> terms;
+  std::vector<uint32_t> clauseOffsets;
+  std::vector<uint32_t> occurrences;
+  std::vector<uint32_t> occurrenceOffsets;
+  std::vector<int32_t> weights;
+};
+}  // namespace
+
+// This work could be extracted into smaller functions for reuse
+WSatInstance::WSatInstance(Builder&& builder) {
+  auto arrays = std::make_shared<BuiltArrays>();
+  arrays->terms = std::move(builder.terms_);
+  arrays->clauseOffsets = std::move(builder.clauseOffsets_);
+  arrays->weights = std::move(builder.weights_);
+  assert(arrays->clauseOffsets.size() > 1);
+  assert(!arrays->weights.empty());
+
+  // Initialize occurrences of variables in two passes over all terms
+  // Count occurrences of each variable, shifted by one for the prefix sum
+  std::vector<uint32_t>& occurrenceOffsets = arrays->occurrenceOffsets;
+  occurrenceOffsets.assign(arrays->weights.size() + 1, 0);
+  for (const Term& term : arrays->terms) {
+    assert(term.id() <= arrays->weights.size());
+    occurrenceOffsets[term.id()]++;
+  }
+  std::partial_sum(
+      occurrenceOffsets.begin(),
+      occurrenceOffsets.end(),
+      occurrenceOffsets.begin()
+  );
+  // Fill clause indices, next free slot of each variable moves forward
+  arrays->occurrences.resize(arrays->terms.size());
+  std::vector<uint32_t> next(
+      occurrenceOffsets.begin(), occurrenceOffsets.end() - 1
+  );
+  const std::vector<uint32_t>& clauseOffsets = arrays->clauseOffsets;
+  for (uint32_t c = 0; c + 1 < clauseOffsets.size(); c++) {
+    for (uint32_t t = clauseOffsets[c]; t < clauseOffsets[c + 1]; t++) {
+      arrays->occurrences[next[arrays->terms[t].id() - 1]++] = c;
     }
-    clauses_.emplace_back(std::move(terms));
   }
 
-  // Initialize Variables
-  // Weights: Seq<int32_t> => Seq<Variable>
-  variables_.reserve(weights.size());
-  for (uint32_t i = 0; i < weights.size(); i++) {
-    // Ids are + 1, because id starts at 1, not 0
-    variables_.emplace_back(i + 1, weights.at(i), clauses_);
-  }
+  terms_ = arrays->terms;
+  clauseOffsets_ = arrays->clauseOffsets;
+  occurrences_ = arrays->occurrences;
+  occurrenceOffsets_ = arrays->occurrenceOffsets;
+  weights_ = arrays->weights;
+  storage_ = std::move(arrays);
 
+  uniformWidth_ = clauseOffsets_[1];
+  for (uint32_t c = 0; c < clauseCount(); c++) {
+    if (clauseOffsets_[c + 1] - clauseOffsets_[c] != uniformWidth_) {
+      uniformWidth_ = 0;
+      break;
+    }
+  }
   // Initialize weight total
   weightTotal_ =
-      std::accumulate(weights.begin(), weights.end(), 0, std::plus<>());
+      std::accumulate(weights_.begin(), weights_.end(), 0, std::plus<>());
+  inverseClauseCount_ = 1 / static_cast<double>(clauseCount());
+  inverseWeightTotal_ = 1 / static_cast<double>(weightTotal_);
 }
 bool WSatInstance::isSatisfiable() const {
-  return std::ranges::all_of(clauses_, [](const Clause& clause) {
+  return std::ranges::all_of(clauses(), [](const Clause& clause) {
     return clause.isSatisfiable();
   });
 }
 int32_t WSatInstance::weightTotal() const { return weightTotal_; }
+uint32_t WSatInstance::uniformWidth() const { return uniformWidth_; }
+double WSatInstance::inverseClauseCount() const { return inverseClauseCount_; }
+double WSatInstance::inverseWeightTotal() const { return inverseWeightTotal_; }
 
 // ===================== EndInstance =====================
+
+// ===================== Builder =====================
+
+void WSatInstance::Builder::problem(
+    uint32_t variableCount, uint32_t clauseCount
+) {
+  variableCount_ = variableCount;
+  clauseOffsets_.reserve(static_cast<size_t>(clauseCount) + 1);
+}
+
+void WSatInstance::Builder::weights(std::span<const int32_t> weights) {
+  weights_.assign(weights.begin(), weights.end());
+}
+
+void WSatInstance::Builder::clause(std::span<const int32_t> literals) {
+  // Terms of each clause are kept unique and sorted
+  uint32_t begin = terms_.size();
+  for (int32_t literal : literals) {
+    Term term(literal);
+    if (term.id() == 0) {
+      throw std::invalid_argument("Clause uses variable 0");
+    }
+    if (term.id() > variableCount_) {
+      throw std::invalid_argument(
+          "Clause uses variable " + std::to_string(term.id()) + " past the " +
+          std::to_string(variableCount_) + " declared"
+      );
+    }
+    terms_.push_back(term);
+  }
+  std::ranges::sort(
+      terms_.begin() + begin,
+      terms_.end(),
+      [](const Term& t1, const Term& t2) { return t1.id() < t2.id(); }
+  );
+  auto duplicates = std::ranges::unique(
+      terms_.begin() + begin,
+      terms_.end(),
+      [](const Term& t1, const Term& t2) { return t1.id() == t2.id(); }
+  );
+  terms_.erase(duplicates.begin(), duplicates.end());
+  clauseOffsets_.push_back(terms_.size());
+}
+
+WSatInstance WSatInstance::Builder::build() && {
+  return WSatInstance(std::move(*this));
+}
+
+// ===================== EndBuilder =====================
@@ -1,6 +1,11 @@
 #ifndef MAXWSATINSTANCE_H
 #define MAXWSATINSTANCE_H
 #include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <ostream>
+#include <ranges>
+#include <span>
 #include <vector>
 
 /** Term with given id can be either plain or negated */
@@ -18,62 +23,175 @@ class Term {
   [[nodiscard]] bool isPlain() const;
 };
 
-/** Clause in CNF - Terms with disjunction between them */
+/** Clause in CNF - view of Terms with disjunction between them */
 class Clause {
  private:
   /** Unique and sorted */
-  std::vector<Term> disjuncts_;
+  std::span<const Term> disjuncts_;
 
  public:
-  explicit Clause(std::vector<Term>&& disjuncts);
+  explicit Clause(std::span<const Term> disjuncts);
   Clause(const Clause& clause) = default;
   Clause& operator=(const Clause& clause) = default;
-  Clause(Clause&& clause) = default;
-  Clause& operator=(Clause&& clause) = default;
   /** Unique and sorted */
-  [[nodiscard]] const std::vector<Term>& disjuncts() const;
+  [[nodiscard]] std::span<const Term> disjuncts() const;
   /** Expensive operation - all pairs must be evaluated */
   [[nodiscard]] bool isSatisfiable() const;
   [[nodiscard]] bool containsVariable(uint32_t variableId) const;
 };
 
-/** Holds info regarding a variable with given id */
+/** View of info regarding a variable with given id */
 class Variable {
  private:
   uint32_t id_;
   int32_t weight_;
-  std::vector<const Clause*> occurrences_;
+  /** Indices of clauses the variable occurs in */
+  std::span<const uint32_t> occurrences_;
 
  public:
   [[nodiscard]] uint32_t id() const;
   [[nodiscard]] int32_t weight() const;
-  [[nodiscard]] const std::vector<const Clause*>& occurences() const;
+  /** Indices into WSatInstance::clauses() */
+  [[nodiscard]] std::span<const uint32_t> occurences() const;
   explicit Variable(
-      uint32_t id, int32_t weight, const std::vector<Clause>& allClauses
+      uint32_t id, int32_t weight, std::span<const uint32_t> occurrences
   );
   Variable(const Variable& variable) = default;
   Variable& operator=(const Variable& variable) = default;
-  Variable(Variable&& variable) = default;
-  Variable& operator=(Variable&& variable) = default;
 };
 
-/** Immutable Max Weighted SAT instance */
+/**
+ * Immutable Max Weighted SAT instance
+ *
+ * Stored in compressed sparse row layout: terms of all clauses are laid out
+ * one after another in a single array and clause i spans the terms between
+ * clauseOffsets()[i] and clauseOffsets()[i + 1]. Occurrences are stored the
+ * same way, variable with index i spans occurrences between
+ * occurrenceOffsets()[i] and occurrenceOffsets()[i + 1]. Clause and Variable
+ * are only views into these arrays created on demand.
+ *
+ * The arrays are immutable and shared by copies. They are either built from
+ * clauses or used in place from a mapped binary image.
+ */
 class WSatInstance {
+ public:
+  class Builder;
+
  private:
-  /** Not indexable by variable id */
-  std::vector<Variable> variables_;
-  std::vector<Clause> clauses_;
+  /** Owns the arrays viewed below, the built vectors or a mapped image */
+  std::shared_ptr<const void> storage_;
+  std::span<const Term> terms_;
+  std::span<const uint32_t> clauseOffsets_;
+  std::span<const uint32_t> occurrences_;
+  std::span<const uint32_t> occurrenceOffsets_;
+  std::span<const int32_t> weights_;
   int32_t weightTotal_;
+  double inverseClauseCount_;
+  double inverseWeightTotal_;
+  uint32_t uniformWidth_;
+
+  WSatInstance() = default;
+  /** Takes over the clauses and weights, builds the rest from them */
+  explicit WSatInstance(Builder&& builder);
 
  public:
-  [[nodiscard]] const std::vector<Variable>& variables() const;
-  [[nodiscard]] const std::vector<Clause>& clauses() const;
+  [[nodiscard]] uint32_t clauseCount() const;
+  [[nodiscard]] uint32_t variableCount() const;
+  [[nodiscard]] Clause clause(uint32_t index) const;
+  /** Variable with id index + 1 */
+  [[nodiscard]] Variable variable(uint32_t index) const;
+
+  /** Random access range of Clause views */
+  [[nodiscard]] auto clauses() const {
+    return std::views::iota(0u, clauseCount()) |
+        std::views::transform([this](uint32_t i) { return clause(i); });
+  }
+  /** Random access range of Variable views, not indexable by variable id */
+  [[nodiscard]] auto variables() const {
+    return std::views::iota(0u, variableCount()) |
+        std::views::transform([this](uint32_t i) { return variable(i); });
+  }
+
+  /// @name Raw layout
+  /// For hot loops, which should stream through the arrays directly
+  ///@{
+  [[nodiscard]] std::span<const Term> terms() const;
+  /** clauseCount() + 1 offsets into terms() */
+  [[nodiscard]] std::span<const uint32_t> clauseOffsets() const;
+  [[nodiscard]] std::span<const uint32_t> occurrences() const;
+  /** variableCount() + 1 offsets into occurrences() */
+  [[nodiscard]] std::span<const uint32_t> occurrenceOffsets() const;
+  /** Indexed by variable id - 1 */
+  [[nodiscard]] std::span<const int32_t> weights() const;
+  ///@}
+
   WSatInstance(
-      std::vector<std::vector<int32_t>>& clauses, std::vector<int32_t>& weights
+      const std::vector<std::vector<int32_t>>& clauses,
+      const std::vector<int32_t>& weights
   );
+  /**
+   * Count of terms shared by all clauses, like 3 for 3-SAT, which lets the
+   * kernels work with a fixed width, 0 if the clauses differ in width
+   */
+  [[nodiscard]] uint32_t uniformWidth() const;
   /** Slow, because it calls isSatisfiable() on all clauses */
   [[nodiscard]] bool isSatisfiable() const;
   [[nodiscard]] int32_t weightTotal() const;
+  /// @name Reciprocals
+  /// Precomputed, so normalizing criteria multiplies instead of divides
+  ///@{
+  [[nodiscard]] double inverseClauseCount() const;
+  [[nodiscard]] double inverseWeightTotal() const;
+  ///@}
+
+  /// @name Binary image
+  /// Versioned and checksummed copy of the arrays in native byte order,
+  /// which loads without parsing or building anything
+  ///@{
+  void writeImage(std::ostream& out) const;
+  /**
+   * Maps the image read only and checks it, throws std::invalid_argument
+   * if it is not a valid image and std::system_error if it is unreadable
+   */
+  [[nodiscard]] static WSatInstance loadImage(
+      const std::filesystem::path& path
+  );
+  /**
+   * Whether the file starts like an image, false if it is unreadable or
+   * not a regular file, which is then left unread
+   */
+  [[nodiscard]] static bool isImage(const std::filesystem::path& path);
+  ///@}
+};
+
+/**
+ * Writes clauses straight into the storage of the instance being built, so
+ * loading holds the literals once instead of in a vector per clause first
+ *
+ * Matches the DimacsConsumer concept of the dimacs module, the parser can
+ * feed it directly.
+ */
+class WSatInstance::Builder {
+ private:
+  friend class WSatInstance;
+  std::vector<Term> terms_;
+  std::vector<uint32_t> clauseOffsets_{0};
+  std::vector<int32_t> weights_;
+  uint32_t variableCount_ = 0;
+
+ public:
+  /** Reserves room for clause offsets by the count announced */
+  void problem(uint32_t variableCount, uint32_t clauseCount);
+  /** Replaces the weights set before */
+  void weights(std::span<const int32_t> weights);
+  /**
+   * Terms are sorted and deduplicated in place, throws
+   * std::invalid_argument for a literal 0 or one past the variables
+   * announced by problem()
+   */
+  void clause(std::span<const int32_t> literals);
+  /** Needs some weights and clauses, the builder is used up */
+  [[nodiscard]] WSatInstance build() &&;
 };
 
 #endif  // MAXWSATINSTANCE_H
@@ -0,0 +1,210 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include "WSatInstance.h"
+
+// Image is a header followed by a payload with the arrays, each padded to
+// whole words, and the payload itself padded to whole checksum blocks
+
+static_assert(sizeof(Term) == sizeof(int32_t));
+static_assert(std::is_trivially_copyable_v<Term>);
+
+namespace {
+
+constexpr std::array<char, 8> imageMagic{
+    'M', 'W', 'S', 'A', 'T', 'I', 'M', 'G'
+};
+/** Bumped on any change of the layout */
+constexpr uint32_t imageVersion = 1;
+/** Reads differently in the other byte order */
+constexpr uint32_t imageByteOrder = 0x01020304;
+/** Words checksummed independently, so the hashes pipeline */
+constexpr size_t checksumLanes = 4;
+
+struct ImageHeader {
+  std::array<char, 8> magic;
+  uint32_t version;
+  uint32_t byteOrder;
+  uint32_t variableCount;
+  uint32_t clauseCount;
+  uint64_t termCount;
+  int32_t weightTotal;
+  uint32_t uniformWidth;
+  uint64_t payloadSize;
+  uint64_t checksum;
+};
+static_assert(sizeof(ImageHeader) % sizeof(uint64_t) == 0);
+
+/** Byte offsets of the arrays in the payload */
+struct ImageLayout {
+  size_t terms;
+  size_t clauseOffsets;
+  size_t occurrences;
+  size_t occurrenceOffsets;
+  size_t weights;
+  size_t size;
+
+  ImageLayout(
+      uint32_t variableCount, uint32_t clauseCount, uint64_t termCount
+  ) {
+    size_t end = 0;
+    auto place = [&end](uint64_t count) {
+      size_t offset = end;
+      end += (count * sizeof(uint32_t) + 7) / 8 * 8;
+      return offset;
+    };
+    terms = place(termCount);
+    clauseOffsets = place(static_cast<uint64_t>(clauseCount) + 1);
+    occurrences = place(termCount);
+    occurrenceOffsets = place(static_cast<uint64_t>(variableCount) + 1);
+    weights = place(variableCount);
+    constexpr size_t block = checksumLanes * sizeof(uint64_t);
+    size = (end + block - 1) / block * block;
+  }
+};
+
+/**
+ * Multiply rotate hash of whole words, cheap enough to check on every load
+ * while any single changed word changes it
+ */
+uint64_t checksum(const uint64_t* words, size_t count) {
+  std::array<uint64_t, checksumLanes> hashes{1, 2, 3, 4};
+  for (size_t i = 0; i < count; i += checksumLanes) {
+    for (size_t lane = 0; lane < checksumLanes; lane++) {
+      hashes[lane] = std::rotl(hashes[lane] ^ words[i + lane], 29) *
+          0x9e3779b97f4a7c15ULL;
+    }
+  }
+  uint64_t hash = 0;
+  for (uint64_t laneHash : hashes) hash = std::rotl(hash, 17) ^ laneHash;
+  return hash;
+}
+
+template <typename T>
+std::span<const T> arrayAt(const char* payload, size_t offset, uint64_t count) {
+  return {reinterpret_cast<const T*>(payload + offset), count};
+}
+
+}  // namespace
+
+void WSatInstance::writeImage(std::ostream& out) const {
+  ImageLayout layout(variableCount(), clauseCount(), terms_.size());
+  std::vector<uint64_t> payload(layout.size / sizeof(uint64_t));
+  auto* bytes = reinterpret_cast<char*>(payload.data());
+  auto copy = [bytes](size_t offset, auto array) {
+    std::memcpy(bytes + offset, array.data(), array.size_bytes());
+  };
+  copy(layout.terms, terms_);
+  copy(layout.clauseOffsets, clauseOffsets_);
+  copy(layout.occurrences, occurrences_);
+  copy(layout.occurrenceOffsets, occurrenceOffsets_);
+  copy(layout.weights, weights_);
+
+  ImageHeader header{
+      imageMagic,
+      imageVersion,
+      imageByteOrder,
+      variableCount(),
+      clauseCount(),
+      terms_.size(),
+      weightTotal_,
+      uniformWidth_,
+      layout.size,
+      checksum(payload.data(), payload.size())
+  };
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(bytes, static_cast<std::streamsize>(layout.size));
+}
+
+WSatInstance WSatInstance::loadImage(const std::filesystem::path& path) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat status {};
+  if (fd < 0 || fstat(fd, &status) != 0) {
+    int error = errno;
+    if (fd >= 0) close(fd);
+    throw std::system_error(
+        error, std::generic_category(), "Cannot open " + path.string()
+    );
+  }
+  auto size = static_cast<size_t>(status.st_size);
+  if (size < sizeof(ImageHeader)) {
+    close(fd);
+    throw std::invalid_argument("Image ended unexpectedly");
+  }
+  // Populated up front, the checksum reads every page anyway
+  void* data =
+      mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+  int error = errno;
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::system_error(
+        error, std::generic_category(), "Cannot map " + path.string()
+    );
+  }
+  std::shared_ptr<const void> mapping(data, [size](const void* mapped) {
+    munmap(const_cast<void*>(mapped), size);
+  });
+
+  ImageHeader header{};
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != imageMagic)
+    throw std::invalid_argument("File is not an instance image");
+  if (header.byteOrder != imageByteOrder)
+    throw std::invalid_argument("Image has other byte order");
+  if (header.version != imageVersion)
+    throw std::invalid_argument("Image has unsupported version");
+  ImageLayout layout(
+      header.variableCount, header.clauseCount, header.termCount
+  );
+  if (header.variableCount == 0 || header.clauseCount == 0 ||
+      header.payloadSize != layout.size ||
+      size != sizeof(header) + layout.size)
+    throw std::invalid_argument("Image has inconsistent size");
+  const char* payload = static_cast<const char*>(data) + sizeof(header);
+  if (checksum(
+          reinterpret_cast<const uint64_t*>(payload),
+          layout.size / sizeof(uint64_t)
+      ) != header.checksum)
+    throw std::invalid_argument("Image checksum does not match");
+
+  WSatInstance instance;
+  instance.terms_ = arrayAt<Term>(payload, layout.terms, header.termCount);
+  instance.clauseOffsets_ = arrayAt<uint32_t>(
+      payload, layout.clauseOffsets, header.clauseCount + 1ULL
+  );
+  instance.occurrences_ =
+      arrayAt<uint32_t>(payload, layout.occurrences, header.termCount);
+  instance.occurrenceOffsets_ = arrayAt<uint32_t>(
+      payload, layout.occurrenceOffsets, header.variableCount + 1ULL
+  );
+  instance.weights_ =
+      arrayAt<int32_t>(payload, layout.weights, header.variableCount);
+  instance.storage_ = std::move(mapping);
+  instance.weightTotal_ = header.weightTotal;
+  instance.uniformWidth_ = header.uniformWidth;
+  instance.inverseClauseCount_ = 1 / static_cast<double>(header.clauseCount);
+  instance.inverseWeightTotal_ = 1 / static_cast<double>(header.weightTotal);
+  return instance;
+}
+
+bool WSatInstance::isImage(const std::filesystem::path& path) {
+  // Reading a pipe would take the bytes away from the parser
+  std::error_code error;
+  if (!std::filesystem::is_regular_file(path, error)) return false;
+  std::ifstream in(path, std::ios::binary);
+  std::array<char, 8> magic{};
+  in.read(magic.data(), magic.size());
+  return in && magic == imageMagic;
+}
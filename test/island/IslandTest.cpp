@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Cooling.h"
+#include "IslandChannel.h"
+#include "IslandCoordinator.h"
+#include "IslandProtocol.h"
+#include "IslandWorker.h"
+#include "Rng.h"
+#include "SatConfig.h"
+#include "SatCooling.h"
+
+namespace {
+SatCooling makeProblem() {
+  std::vector<std::vector<int32_t>> clauses;
+  for (int32_t i = 1; i <= 80; i++) {
+    clauses.push_back({i % 20 + 1, -(i * 3 % 20 + 1), i * 7 % 20 + 1});
+  }
+  std::vector<int32_t> weights(20);
+  for (int32_t i = 0; i < 20; i++) weights[i] = i * 5 % 11 + 1;
+  return SatCooling(clauses, weights);
+}
+
+std::filesystem::path socketPath(const std::string& name) {
+  return std::filesystem::temp_directory_path() /
+      (name + "_" + std::to_string(::getpid()) + ".sock");
+}
+}  // namespace
+
+TEST(IslandTest, reportsRoundTrip) {
+  SatCooling problem = makeProblem();
+  Rng rng = Rng::fromSeed(1);
+  IslandReport report{
+      .stepsTotal = 7,
+      .stepsSinceChange = 2,
+      .stepsSinceBetterment = 5,
+      .endedBecause = "gain",
+      .configuration = problem.getRandomConfiguration(rng),
+  };
+  std::string payload = encodeReport(problem, report);
+  IslandReport decoded = decodeReport(problem, payload);
+  ASSERT_EQ(decoded.stepsTotal, 7);
+  ASSERT_EQ(decoded.stepsSinceChange, 2);
+  ASSERT_EQ(decoded.stepsSinceBetterment, 5);
+  ASSERT_EQ(decoded.endedBecause, "gain");
+  ASSERT_EQ(decoded.configuration, report.configuration);
+
+  ASSERT_THROW(
+      (void)decodeReport(problem, payload.substr(0, payload.size() - 1)),
+      std::invalid_argument
+  );
+  ASSERT_THROW(
+      (void)decodeReport(problem, payload + "x"), std::invalid_argument
+  );
+  ASSERT_EQ(decodeIndex(encodeIndex(3)), 3);
+}
+
+TEST(IslandTest, islandsShareTheElite) {
+  SatCooling problem = makeProblem();
+  constexpr uint32_t islandCount = 3;
+  std::filesystem::path path = socketPath("island_elite");
+  IslandCoordinator coordinator(problem, path, islandCount);
+
+  std::vector<uint32_t> indices(islandCount);
+  {
+    std::vector<std::jthread> workers;
+    for (uint32_t i = 0; i < islandCount; i++) {
+      workers.emplace_back([&, i] {
+        IslandWorker worker(problem, path, std::chrono::seconds(5));
+        indices[i] = worker.index();
+        Rng rng = Rng::fromSeed(10);
+        for (uint32_t jump = 0; jump < worker.index(); jump++) rng.jump();
+        // Hot and short, so the islands differ when they exchange
+        CoolingSchedule schedule(
+            20, 0.9, 1, 0.01, UINT32_MAX, UINT32_MAX, UINT32_MAX
+        );
+        Cooling<SatConfig, SatCriteria, SatCooling> chain(
+            problem, schedule, rng
+        );
+        worker.run(chain, 1);
+      });
+    }
+    coordinator.run();
+  }
+
+  std::sort(indices.begin(), indices.end());
+  ASSERT_EQ(indices, (std::vector<uint32_t>{0, 1, 2}));
+  ASSERT_GT(coordinator.getMigrations(), 0);
+  for (uint32_t i = 0; i < islandCount; i++) {
+    const IslandCoordinator::Island& island = coordinator.island(i);
+    ASSERT_TRUE(island.finished);
+    ASSERT_EQ(island.endedBecause(), "temperature");
+    ASSERT_GT(island.getStepsTotal(), 0);
+    SatCriteria full = problem.evaluateFully(island.copyBestConfiguration());
+    ASSERT_EQ(full.weight(), island.getBestCriteria().weight());
+  }
+  const IslandCoordinator::Island& best =
+      coordinator.island(coordinator.bestIndex());
+  for (uint32_t i = 0; i < islandCount; i++) {
+    ASSERT_FALSE(best.getBestCriteria() < coordinator.island(i).criteria);
+  }
+  // Listener removes its socket
+  ASSERT_FALSE(std::filesystem::exists(path));
+}
+
+TEST(IslandTest, rejectsBrokenProtocol) {
+  SatCooling problem = makeProblem();
+  std::filesystem::path path = socketPath("island_broken");
+  IslandCoordinator coordinator(problem, path, 1);
+  std::jthread worker([&] {
+    IslandChannel channel =
+        IslandChannel::connect(path, std::chrono::seconds(5));
+    channel.send(IslandMessage::report);
+  });
+  ASSERT_THROW(coordinator.run(), std::invalid_argument);
+}
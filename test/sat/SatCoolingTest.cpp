@@ -1,12 +1,86 @@
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <random>
+#include <sstream>
+#include <thread>
 
+#include "Cooling.h"
+#include "ParallelTempering.h"
+#include "Portfolio.h"
+#include "Rng.h"
+#include "RngLanes.h"
 #include "SatConfig.h"
 #include "SatCooling.h"
+#include "SatEvaluation.h"
+#include "SatLockstep.h"
+#include "SatSharedBest.h"
 #include "WSatInstance.h"
 #include "dimacsParsing.h"
 
+namespace {
+/** 80 clauses of 3 literals over 20 variables, weighted from 1 to 11 */
+std::shared_ptr<const WSatInstance> makeInstance() {
+  std::vector<std::vector<int32_t>> clauses;
+  for (int32_t i = 1; i <= 80; i++) {
+    clauses.push_back({i % 20 + 1, -(i * 3 % 20 + 1), i * 7 % 20 + 1});
+  }
+  std::vector<int32_t> weights(20);
+  for (int32_t i = 0; i < 20; i++) weights[i] = i * 5 % 11 + 1;
+  return std::make_shared<const WSatInstance>(clauses, weights);
+}
+
+/** Short run over makeInstance(), ending 500 steps without gain */
+CoolingSchedule makeSchedule() {
+  return {50, 0.95, 10, 0.1, UINT32_MAX, UINT32_MAX, 500};
+}
+
+/** Clauses over 30 variables, satisfiable by all true, weighted 1 each */
+std::shared_ptr<const WSatInstance> makeSatisfiable(int32_t clauseCount) {
+  std::vector<std::vector<int32_t>> clauses;
+  for (int32_t i = 1; i <= clauseCount; i++) {
+    clauses.push_back({i % 30 + 1, -(i * 7 % 30 + 1), i * 11 % 30 + 1});
+  }
+  std::vector<int32_t> weights(30, 1);
+  return std::make_shared<const WSatInstance>(clauses, weights);
+}
+
+/** Cools from 1e-2 to 1e-5, which solves makeSatisfiable(120) */
+CoolingSchedule makeLongSchedule() {
+  return {500, 0.9, 1e-2, 1e-5, UINT32_MAX, UINT32_MAX, UINT32_MAX};
+}
+
+/** Random clauses of 3 literals over 40 variables, weighted from 1 to 11 */
+std::shared_ptr<const WSatInstance> makeRandom(
+    uint32_t seed, int32_t clauseCount
+) {
+  std::mt19937 engine(seed);
+  auto literal = [&] {
+    auto id = static_cast<int32_t>(engine() % 40 + 1);
+    return engine() % 2 == 0 ? id : -id;
+  };
+  std::vector<std::vector<int32_t>> clauses;
+  for (int32_t i = 1; i <= clauseCount; i++) {
+    clauses.push_back({literal(), literal(), literal()});
+  }
+  std::vector<int32_t> weights(40);
+  for (int32_t i = 0; i < 40; i++) weights[i] = i * 5 % 11 + 1;
+  return std::make_shared<const WSatInstance>(clauses, weights);
+}
+
+/** SatCooling without moves, so Cooling copies and scores whole neighbors */
+class NeighborSatCooling : private SatCooling {
+ public:
+  using SatCooling::evaluateConfiguration;
+  using SatCooling::evaluateFully;
+  using SatCooling::evaluateProposed;
+  using SatCooling::getRandomConfiguration;
+  using SatCooling::getRandomNeighbor;
+  explicit NeighborSatCooling(const SatCooling& problem)
+      : SatCooling(problem) {}
+};
+}  // namespace
+
 TEST(WSatSolverTest, initialization) {
   std::string example = R"(c MWCNF Example
 c 4 variables, 6 clauses
@@ -77,28 +151,681 @@ w 2 4 1 6 0
   SatConfig config = SatConfig(std::move(init));
   SatCooling cooling(res.clauses, res.weights);
 
-  config.underlying[3] = true;
+  config.set(4, true);
   SatCriteria criteria = cooling.evaluateConfiguration(config);
   // 0 0 0 1
   ASSERT_EQ(criteria.satisfied(), 6);
   ASSERT_EQ(criteria.weight(), 6);
 
   // 1 0 0 1
-  config.underlying[0] = true;
+  config.set(1, true);
   criteria = cooling.evaluateConfiguration(config);
   ASSERT_EQ(criteria.satisfied(), 6);
   ASSERT_EQ(criteria.weight(), 8);
 
   // 1 0 1 1
-  config.underlying[2] = true;
+  config.set(3, true);
   criteria = cooling.evaluateConfiguration(config);
 
   ASSERT_EQ(criteria.satisfied(), 4);
   ASSERT_EQ(criteria.weight(), 9);
 
   // 1 1 1 1
-  config.underlying[1] = true;
+  config.set(2, true);
   criteria = cooling.evaluateConfiguration(config);
   ASSERT_EQ(criteria.satisfied(), 5);
   ASSERT_EQ(criteria.weight(), 13);
-}
\ No newline at end of file
+}
+TEST(WSatSolverTest, incrementalMatchesFullScan) {
+  std::string example = R"(c MWCNF Example
+c 4 variables, 6 clauses
+c each clause is terminated by '0' (not by the end of line)
+p mwcnf 4 6
+c zero-terminated as the clauses
+w 2 4 1 6 0
+1 -3 4 0
+-1 2 -3 0
+3 4 0
+1 2 -3 -4 0
+-2 3 0
+-3 -4 0)";
+  std::stringstream ss(example);
+  ParsedDimacsFile res = parseDimacsFile(ss);
+  SatCooling cooling(res.clauses, res.weights);
+  Rng rng = Rng::fromSeed(1);
+
+  SatConfig current = cooling.getRandomConfiguration(rng);
+  ASSERT_EQ(
+      cooling.evaluateConfiguration(current).satisfied(),
+      cooling.evaluateFully(current).satisfied()
+  );
+  for (int i = 0; i < 200; i++) {
+    SatConfig neighbor = cooling.getRandomNeighbor(current, rng);
+    SatCriteria incremental = cooling.evaluateProposed(neighbor);
+    SatCriteria full = cooling.evaluateFully(neighbor);
+    ASSERT_EQ(incremental.satisfied(), full.satisfied());
+    ASSERT_EQ(incremental.weight(), full.weight());
+    // Accept every other neighbor
+    if (i % 2 == 0) current = neighbor;
+  }
+  // A neighbor changed in place is scanned fully, and tracked afterwards
+  for (uint32_t other = 1; other <= current.size(); other++) {
+    SatConfig neighbor = cooling.getRandomNeighbor(current, rng);
+    neighbor.flip(other);
+    SatCriteria criteria = cooling.evaluateConfiguration(neighbor);
+    SatCriteria full = cooling.evaluateFully(neighbor);
+    ASSERT_EQ(criteria.satisfied(), full.satisfied());
+    ASSERT_EQ(criteria.weight(), full.weight());
+    current = neighbor;
+    neighbor = cooling.getRandomNeighbor(current, rng);
+    criteria = cooling.evaluateProposed(neighbor);
+    full = cooling.evaluateFully(neighbor);
+    ASSERT_EQ(criteria.satisfied(), full.satisfied());
+    ASSERT_EQ(criteria.weight(), full.weight());
+  }
+}
+
+TEST(WSatSolverTest, coolingScoresProposedNeighbors) {
+  NeighborSatCooling problem{SatCooling(makeRandom(3, 160), 0.3)};
+  using Chain = Cooling<SatConfig, SatCriteria, NeighborSatCooling>;
+  static_assert(
+      ProposedProblemable<NeighborSatCooling, SatConfig, SatCriteria>
+  );
+  static_assert(!MoveProblemable<NeighborSatCooling, SatConfig, SatCriteria>);
+  Rng rng = Rng::fromSeed(5);
+  SatConfig start = problem.getRandomConfiguration(rng);
+  Chain chain(problem, start, makeSchedule(), rng);
+  for (int i = 0; i < 20 && chain.runEquilibrium(); i++) {
+    SatCriteria full = problem.evaluateFully(chain.getCurrentConfiguration());
+    ASSERT_EQ(chain.getCurrentCriteria().satisfied(), full.satisfied());
+    ASSERT_EQ(chain.getCurrentCriteria().weight(), full.weight());
+  }
+}
+
+TEST(WSatSolverTest, movesMatchFullScan) {
+  std::string example = R"(c MWCNF Example
+c 4 variables, 6 clauses
+c each clause is terminated by '0' (not by the end of line)
+p mwcnf 4 6
+c zero-terminated as the clauses
+w 2 4 1 6 0
+1 -3 4 0
+-1 2 -3 0
+3 4 0
+1 2 -3 -4 0
+-2 3 0
+-3 -4 0)";
+  std::stringstream ss(example);
+  ParsedDimacsFile res = parseDimacsFile(ss);
+  SatCooling cooling(res.clauses, res.weights);
+  Rng rng = Rng::fromSeed(1);
+  static_assert(MoveProblemable<SatCooling, SatConfig, SatCriteria>);
+
+  SatConfig current = cooling.getRandomConfiguration(rng);
+  ASSERT_EQ(
+      cooling.evaluateConfiguration(current).satisfied(),
+      cooling.evaluateFully(current).satisfied()
+  );
+  for (int i = 0; i < 200; i++) {
+    SatCooling::Move move = cooling.proposeMove(current, rng);
+    SatCriteria proposed = cooling.evaluateMove(current, move);
+    SatConfig neighbor = current;
+    neighbor.flip(move);
+    SatCriteria full = cooling.evaluateFully(neighbor);
+    ASSERT_EQ(proposed.satisfied(), full.satisfied());
+    ASSERT_EQ(proposed.weight(), full.weight());
+    // Apply every other move
+    if (i % 2 == 0) cooling.applyMove(current, move);
+  }
+}
+
+TEST(WSatSolverTest, walkFlipsUnsatisfiedClauses) {
+  std::string example = R"(c MWCNF Example
+c 4 variables, 6 clauses
+c each clause is terminated by '0' (not by the end of line)
+p mwcnf 4 6
+c zero-terminated as the clauses
+w 2 4 1 6 0
+1 -3 4 0
+-1 2 -3 0
+3 4 0
+1 2 -3 -4 0
+-2 3 0
+-3 -4 0)";
+  std::stringstream ss(example);
+  ParsedDimacsFile res = parseDimacsFile(ss);
+  SatCooling cooling(res.clauses, res.weights, 1);
+  Rng rng = Rng::fromSeed(1);
+  WSatInstance instance(res.clauses, res.weights);
+
+  SatConfig current(std::vector<bool>{true, true, true, true});
+  ASSERT_FALSE(cooling.evaluateConfiguration(current).isSatisfied());
+  for (int i = 0; i < 200; i++) {
+    std::vector<uint32_t> counts(instance.clauseCount());
+    uint32_t satisfied = countTrueLiterals(instance, current, counts);
+    if (satisfied == instance.clauseCount()) break;
+
+    SatCooling::Move move = cooling.proposeMove(current, rng);
+    bool inUnsatisfied = false;
+    for (uint32_t clause : instance.variable(move - 1).occurences()) {
+      inUnsatisfied = inUnsatisfied || counts[clause] == 0;
+    }
+    ASSERT_TRUE(inUnsatisfied);
+    cooling.applyMove(current, move);
+  }
+}
+
+TEST(WSatSolverTest, movesMatchFullScanUniformWidth) {
+  // 3-SAT takes the fixed width path
+  std::vector<std::vector<int32_t>> clauses;
+  for (int32_t i = 1; i <= 40; i++) {
+    clauses.push_back({i % 10 + 1, -(i * 3 % 10 + 11), i * 7 % 5 + 21});
+  }
+  std::vector<int32_t> weights(25);
+  for (int32_t i = 0; i < 25; i++) weights[i] = i + 1;
+  ASSERT_EQ(WSatInstance(clauses, weights).uniformWidth(), 3);
+  SatCooling cooling(clauses, weights, 0.5);
+  Rng rng = Rng::fromSeed(1);
+
+  SatConfig current = cooling.getRandomConfiguration(rng);
+  ASSERT_EQ(
+      cooling.evaluateConfiguration(current).satisfied(),
+      cooling.evaluateFully(current).satisfied()
+  );
+  for (int i = 0; i < 500; i++) {
+    SatCooling::Move move = cooling.proposeMove(current, rng);
+    SatCriteria proposed = cooling.evaluateMove(current, move);
+    SatConfig neighbor = current;
+    neighbor.flip(move);
+    SatCriteria full = cooling.evaluateFully(neighbor);
+    ASSERT_EQ(proposed.satisfied(), full.satisfied());
+    ASSERT_EQ(proposed.weight(), full.weight());
+    if (i % 3 != 0) cooling.applyMove(current, move);
+  }
+}
+
+TEST(WSatSolverTest, flipScoresMatchFullScan) {
+  std::vector<std::vector<int32_t>> clauses;
+  for (int32_t i = 1; i <= 60; i++) {
+    std::vector<int32_t> clause;
+    for (int32_t j = 0; j < i % 4 + 1; j++) {
+      int32_t id = (i * 7 + j * 5) % 15 + 1;
+      clause.push_back((i + j) % 3 == 0 ? -id : id);
+    }
+    clauses.push_back(clause);
+  }
+  std::vector<int32_t> weights(15);
+  for (int32_t i = 0; i < 15; i++) weights[i] = i * 3 % 7 + 1;
+  SatCooling cooling(clauses, weights, 0.3);
+  Rng rng = Rng::fromSeed(1);
+
+  SatConfig current = cooling.getRandomConfiguration(rng);
+  SatCriteria criteria = cooling.evaluateConfiguration(current);
+  for (int i = 0; i < 100; i++) {
+    for (uint32_t id = 1; id <= current.size(); id++) {
+      SatCooling::FlipScore score = cooling.flipScore(current, id);
+      SatConfig neighbor = current;
+      neighbor.flip(id);
+      SatCriteria full = cooling.evaluateFully(neighbor);
+      ASSERT_EQ(
+          score.satisfiedDelta(),
+          static_cast<int32_t>(full.satisfied()) -
+              static_cast<int32_t>(criteria.satisfied())
+      );
+      ASSERT_EQ(score.weightDelta, full.weight() - criteria.weight());
+      ASSERT_LE(score.breakCount, criteria.satisfied());
+    }
+    SatCooling::Move move = cooling.proposeMove(current, rng);
+    criteria = cooling.evaluateMove(current, move);
+    cooling.applyMove(current, move);
+  }
+}
+
+TEST(WSatSolverTest, portfolioIsDeterministic) {
+  SatCooling cooling(makeInstance());
+  using SatPortfolio = Portfolio<SatConfig, SatCriteria, SatCooling>;
+  CoolingSchedule schedule = makeSchedule();
+
+  std::vector<SatConfig> starts(4);
+  auto solve = [&] {
+    SatPortfolio portfolio(4);
+    portfolio.run(
+        Rng::fromSeed(42),
+        [&](uint32_t chain, Rng rng) {
+          starts[chain] = cooling.getRandomConfiguration(rng);
+          return SatPortfolio::Chain(cooling, starts[chain], schedule, rng);
+        },
+        [](SatPortfolio::Chain& chain, uint32_t) { chain.simulateCooling(); }
+    );
+    return portfolio;
+  };
+  SatPortfolio first = solve();
+  SatPortfolio second = solve();
+  ASSERT_EQ(first.bestIndex(), second.bestIndex());
+  for (uint32_t i = 0; i < first.size(); i++) {
+    ASSERT_EQ(
+        first.chain(i).getBestConfiguration(),
+        second.chain(i).getBestConfiguration()
+    );
+    ASSERT_EQ(first.chain(i).getStepsTotal(), second.chain(i).getStepsTotal());
+  }
+  // Every chain draws from its own stream
+  ASSERT_NE(starts[0], starts[1]);
+}
+
+TEST(WSatSolverTest, portfolioRethrowsErrorOfChain) {
+  SatCooling cooling(makeInstance());
+  using SatPortfolio = Portfolio<SatConfig, SatCriteria, SatCooling>;
+  CoolingSchedule schedule = makeSchedule();
+
+  SatPortfolio portfolio(4);
+  std::atomic<uint32_t> finished{0};
+  try {
+    portfolio.run(
+        Rng::fromSeed(42),
+        [&](uint32_t chain, Rng rng) {
+          if (chain == 3) throw std::runtime_error("made 3");
+          SatConfig start = cooling.getRandomConfiguration(rng);
+          return SatPortfolio::Chain(cooling, start, schedule, rng);
+        },
+        [&](SatPortfolio::Chain& chain, uint32_t index) {
+          if (index == 1) throw std::runtime_error("ran 1");
+          chain.simulateCooling();
+          finished++;
+        }
+    );
+    FAIL() << "Errors of chains were lost";
+  } catch (const std::runtime_error& error) {
+    // The lowest chain index wins, after the other chains finished
+    ASSERT_STREQ(error.what(), "ran 1");
+  }
+  ASSERT_EQ(finished, 2);
+}
+
+TEST(WSatSolverTest, parallelTemperingIsIndependentOfThreads) {
+  SatCooling cooling(makeInstance(), 0.2);
+  using SatTempering = ParallelTempering<SatConfig, SatCriteria, SatCooling>;
+  std::vector<double> ladder = SatTempering::geometricLadder(0.001, 0.1, 5);
+  ASSERT_DOUBLE_EQ(ladder.front(), 0.001);
+  ASSERT_DOUBLE_EQ(ladder.back(), 0.1);
+
+  SatTempering single(cooling, ladder, Rng::fromSeed(3));
+  single.run(40, 25, 1);
+  SatTempering parallel(cooling, ladder, Rng::fromSeed(3));
+  parallel.run(40, 25, 3);
+  ASSERT_EQ(single.getRounds(), 40);
+  for (uint32_t slot = 0; slot < ladder.size(); slot++) {
+    ASSERT_EQ(
+        single.replica(slot).getCurrentConfiguration(),
+        parallel.replica(slot).getCurrentConfiguration()
+    );
+    ASSERT_DOUBLE_EQ(single.replica(slot).getTemperature(), ladder[slot]);
+  }
+  for (uint32_t pair = 0; pair + 1 < ladder.size(); pair++) {
+    ASSERT_EQ(single.pairStats(pair).attempted, 20);
+    ASSERT_EQ(
+        single.pairStats(pair).accepted, parallel.pairStats(pair).accepted
+    );
+  }
+  ASSERT_EQ(
+      single.best().getBestCriteria().weight(),
+      parallel.best().getBestCriteria().weight()
+  );
+}
+
+TEST(WSatSolverTest, schedulePolicies) {
+  CoolingSchedule schedule(100, 0.5, 8, 0.125, 1000, UINT32_MAX, UINT32_MAX);
+  EquilibriumStats full{100, 30, 100};
+
+  GeometricCooling geometric(schedule);
+  ASSERT_FALSE(geometric.isEquilibriumOver({99, 99, 99}));
+  ASSERT_TRUE(geometric.isEquilibriumOver(full));
+  ASSERT_DOUBLE_EQ(geometric.nextTemperature(full, 8), 4);
+
+  // Reaches the stop temperature after as many equilibria as geometric
+  LundyMeesCooling lundyMees(schedule);
+  double temperature = 8;
+  for (int i = 0; i < 6; i++) {
+    temperature = lundyMees.nextTemperature(full, temperature);
+  }
+  ASSERT_NEAR(temperature, 0.125, 1e-9);
+
+  // Cools while accepting more than the target, heats up otherwise
+  LamCooling lam(schedule);
+  ASSERT_DOUBLE_EQ(LamCooling::targetRate(0), 1);
+  ASSERT_DOUBLE_EQ(LamCooling::targetRate(0.5), 0.44);
+  ASSERT_DOUBLE_EQ(lam.nextTemperature({100, 60, 500}, 8), 4);
+  ASSERT_DOUBLE_EQ(lam.nextTemperature({100, 30, 500}, 8), 16);
+
+  AdaptiveEquilibrium adaptive(schedule);
+  ASSERT_TRUE(adaptive.isEquilibriumOver({30, 10, 30}));
+  ASSERT_TRUE(adaptive.isEquilibriumOver({10, 0, 10}));
+  ASSERT_FALSE(adaptive.isEquilibriumOver({30, 9, 30}));
+  ASSERT_TRUE(adaptive.isEquilibriumOver(full));
+}
+
+TEST(WSatSolverTest, adaptiveEquilibriumSolvesInFewerSteps) {
+  SatCooling cooling(makeSatisfiable(120), 0.3);
+  CoolingSchedule schedule = makeLongSchedule();
+
+  Cooling<SatConfig, SatCriteria, SatCooling> geometric(
+      cooling, schedule, Rng::fromSeed(3)
+  );
+  geometric.simulateCooling();
+  Cooling<SatConfig, SatCriteria, SatCooling, AdaptiveEquilibrium> adaptive(
+      cooling, schedule, Rng::fromSeed(3)
+  );
+  adaptive.simulateCooling();
+
+  ASSERT_TRUE(geometric.getBestCriteria().isSatisfied());
+  ASSERT_TRUE(adaptive.getBestCriteria().isSatisfied());
+  ASSERT_LT(adaptive.getStepsTotal(), geometric.getStepsTotal());
+}
+
+TEST(WSatSolverTest, stopsAtTargetAndDeadline) {
+  SatCooling cooling(makeSatisfiable(120), 0.3);
+  CoolingSchedule schedule = makeLongSchedule();
+
+  Cooling<SatConfig, SatCriteria, SatCooling> targeted(
+      cooling, schedule, Rng::fromSeed(3)
+  );
+  targeted.setTarget(cooling.satisfiedWithWeight(0));
+  targeted.simulateCooling();
+  ASSERT_EQ(targeted.endedBecause(), "target");
+  ASSERT_TRUE(targeted.getBestCriteria().isSatisfied());
+
+  // Deadline is only checked when an equilibrium ends
+  schedule.stopAfterTime = std::chrono::steady_clock::duration::zero();
+  Cooling<SatConfig, SatCriteria, SatCooling> timed(
+      cooling, schedule, Rng::fromSeed(3)
+  );
+  timed.simulateCooling();
+  ASSERT_EQ(timed.endedBecause(), "time");
+  ASSERT_EQ(timed.getStepsTotal(), 500);
+}
+
+TEST(WSatSolverTest, resumesFromCheckpointExactly) {
+  SatCooling cooling(makeRandom(7, 200), 0.5);
+  CoolingSchedule schedule(
+      300, 0.95, 1e-2, 1e-5, UINT32_MAX, UINT32_MAX, UINT32_MAX
+  );
+  using SatChain = Cooling<SatConfig, SatCriteria, SatCooling>;
+
+  SatChain uninterrupted(cooling, schedule, Rng::fromSeed(11));
+  SatChain interrupted(cooling, schedule, Rng::fromSeed(11));
+  // Mid equilibrium, with unsatisfied clauses to walk
+  for (int i = 0; i < 432; i++) interrupted.step();
+  ASSERT_FALSE(interrupted.getCurrentCriteria().isSatisfied());
+  std::stringstream checkpoint;
+  interrupted.saveCheckpoint(checkpoint);
+
+  SatChain resumed(cooling, schedule, Rng::fromSeed(12));
+  resumed.loadCheckpoint(checkpoint);
+  // Trajectories would only meet again at the end
+  for (int i = 0; i < 432 + 500; i++) uninterrupted.step();
+  for (int i = 0; i < 500; i++) resumed.step();
+  ASSERT_EQ(
+      resumed.getCurrentConfiguration(),
+      uninterrupted.getCurrentConfiguration()
+  );
+  uninterrupted.simulateCooling();
+  resumed.simulateCooling();
+  ASSERT_EQ(
+      resumed.getBestConfiguration(), uninterrupted.getBestConfiguration()
+  );
+  ASSERT_EQ(
+      resumed.getCurrentConfiguration(),
+      uninterrupted.getCurrentConfiguration()
+  );
+  ASSERT_EQ(resumed.getStepsTotal(), uninterrupted.getStepsTotal());
+  ASSERT_EQ(resumed.getRng().state(), uninterrupted.getRng().state());
+
+  std::stringstream garbage("not a checkpoint");
+  ASSERT_THROW(resumed.loadCheckpoint(garbage), std::invalid_argument);
+  // Cut short anywhere, in the header, configurations or search state
+  std::string saved = checkpoint.str();
+  for (size_t length : {size_t{6}, saved.size() / 2, saved.size() - 1}) {
+    std::stringstream truncated(saved.substr(0, length));
+    ASSERT_THROW(resumed.loadCheckpoint(truncated), std::invalid_argument);
+  }
+}
+
+TEST(WSatSolverTest, batchedStepsMatchSingleSteps) {
+  SatCooling cooling(makeRandom(9, 120), 0.3);
+
+  auto expectSame = [&]<typename Chain>(Chain single) {
+    Chain equilibria = single;
+    Chain batched = single;
+    while (single.step()) {
+    }
+    while (equilibria.runEquilibrium()) {
+    }
+    // Odd batches end in the middle of equilibria
+    while (batched.runSteps(777)) {
+    }
+    for (const Chain* other : {&equilibria, &batched}) {
+      ASSERT_EQ(other->endedBecause(), single.endedBecause());
+      ASSERT_EQ(other->getStepsTotal(), single.getStepsTotal());
+      ASSERT_EQ(other->getStepsSinceChange(), single.getStepsSinceChange());
+      ASSERT_EQ(
+          other->getStepsSinceBetterment(), single.getStepsSinceBetterment()
+      );
+      ASSERT_EQ(other->getTemperature(), single.getTemperature());
+      ASSERT_EQ(
+          other->getBestConfiguration(), single.getBestConfiguration()
+      );
+      ASSERT_EQ(other->getRng().state(), single.getRng().state());
+    }
+  };
+
+  // Each ends for another reason, the last one at the target
+  CoolingSchedule cold(300, 0.9, 1e-3, 1e-6, UINT32_MAX, UINT32_MAX, 20'000);
+  CoolingSchedule unchanged(300, 0.99, 1e-4, 1e-9, 25'000, 60, UINT32_MAX);
+  CoolingSchedule ungained(300, 0.99, 1e-4, 1e-9, 25'000, UINT32_MAX, 3000);
+  CoolingSchedule limited(300, 0.99, 1e-3, 1e-5, 25'000, 200, UINT32_MAX);
+  expectSame(Cooling<SatConfig, SatCriteria, SatCooling>(
+      cooling, cold, Rng::fromSeed(1)
+  ));
+  expectSame(Cooling<SatConfig, SatCriteria, SatCooling>(
+      cooling, limited, Rng::fromSeed(2)
+  ));
+  expectSame(Cooling<SatConfig, SatCriteria, SatCooling>(
+      cooling, unchanged, Rng::fromSeed(2)
+  ));
+  expectSame(Cooling<SatConfig, SatCriteria, SatCooling>(
+      cooling, ungained, Rng::fromSeed(2)
+  ));
+  expectSame(Cooling<SatConfig, SatCriteria, SatCooling, AdaptiveEquilibrium>(
+      cooling, cold, Rng::fromSeed(3)
+  ));
+  Cooling<SatConfig, SatCriteria, SatCooling> targeted(
+      cooling, cold, Rng::fromSeed(4)
+  );
+  targeted.setTarget(cooling.satisfiedWithWeight(1));
+  expectSame(targeted);
+}
+
+TEST(WSatSolverTest, journaledBestMatchesItsCriteria) {
+  // Plain literals only, a sparse satisfying start betters with most flips
+  constexpr uint32_t variables = 20'000;
+  std::mt19937 engine(4);
+  std::vector<std::vector<int32_t>> clauses(variables);
+  for (std::vector<int32_t>& clause : clauses) {
+    for (int i = 0; i < 3; i++)
+      clause.push_back(static_cast<int32_t>(engine() % variables + 1));
+  }
+  std::vector<int32_t> weights(variables);
+  for (int32_t& weight : weights) weight = engine() % 100 + 1;
+  SatCooling cooling(clauses, weights);
+  SatConfig start(variables);
+  for (const std::vector<int32_t>& clause : clauses) start.set(clause[0], 1);
+
+  // Hot enough to also walk away from the best for a while
+  CoolingSchedule schedule(
+      5'000, 0.5, 1e-3, 1e-9, UINT32_MAX, UINT32_MAX, UINT32_MAX
+  );
+  static_assert(JournalProblemable<SatCooling, SatConfig, SatCriteria>);
+  Cooling<SatConfig, SatCriteria, SatCooling> journaled(
+      cooling, start, schedule, Rng::fromSeed(5)
+  );
+  // Longer than the journal between checks
+  while (journaled.runSteps(10'007)) {
+    SatCriteria full = cooling.evaluateFully(journaled.getBestConfiguration());
+    ASSERT_EQ(full.weight(), journaled.getBestCriteria().weight());
+    ASSERT_EQ(full.satisfied(), journaled.getBestCriteria().satisfied());
+  }
+  ASSERT_GT(journaled.getBestCriteria().weight(), 0);
+}
+
+TEST(WSatSolverTest, lockstepLanesAreIndependentChains) {
+  // Lane k draws the numbers of the stream jumped k times
+  Rng rng = Rng::fromSeed(8);
+  std::vector<Rng> streams;
+  for (uint32_t k = 0; k < 4; k++) {
+    streams.push_back(rng);
+    rng.jump();
+  }
+  RngLanes<4> rngLanes{std::span<const Rng, 4>(streams)};
+  RngLanes<4>::PerLane<uint64_t> words;
+  RngLanes<4>::PerLane<double> samples;
+  for (int i = 0; i < 100; i++) {
+    rngLanes.next(words);
+    rngLanes.nextExponential(samples);
+    for (uint32_t k = 0; k < 4; k++) {
+      ASSERT_EQ(words[k], streams[k].next());
+      ASSERT_EQ(samples[k], streams[k].nextExponential());
+    }
+  }
+  ASSERT_EQ(rngLanes.lane(2).next(), streams[2].next());
+
+  std::shared_ptr<const WSatInstance> instance = makeInstance();
+  SatCooling cooling(instance);
+  // Lanes 6 and 7 start colder than the stop temperature
+  CoolingSchedule schedule(50, 0.95, 10, 0.1, UINT32_MAX, UINT32_MAX, 800);
+  auto solve = [&] {
+    SatLockstep<8> lockstep(instance, schedule, Rng::fromSeed(42), 2, 0.4);
+    lockstep.simulateCooling();
+    return lockstep;
+  };
+  SatLockstep<8> first = solve();
+  SatLockstep<8> second = solve();
+  ASSERT_EQ(first.bestLane(), second.bestLane());
+  for (uint32_t k = 0; k < first.size(); k++) {
+    SatLockstep<8>::Lane lane = first.lane(k);
+    ASSERT_EQ(lane.getBestConfiguration(),
+              second.lane(k).getBestConfiguration());
+    ASSERT_EQ(lane.getStepsTotal(), second.lane(k).getStepsTotal());
+    SatCriteria full = cooling.evaluateFully(lane.getBestConfiguration());
+    ASSERT_EQ(full.weight(), lane.getBestCriteria().weight());
+    ASSERT_EQ(full.satisfied(), lane.getBestCriteria().satisfied());
+    if (k < 6) {
+      ASSERT_GT(lane.getStepsTotal(), 0);
+    } else {
+      ASSERT_EQ(lane.endedBecause(), "temperature");
+      ASSERT_EQ(lane.getStepsTotal(), 0);
+    }
+  }
+  // Warmer lanes run until they stop gaining, each at its own pace
+  ASSERT_EQ(first.lane(0).endedBecause(), "gain");
+  ASSERT_NE(first.lane(0).getStepsTotal(), first.lane(1).getStepsTotal());
+}
+
+TEST(WSatSolverTest, movesToMigrant) {
+  // Every clause is a positive literal, all true is the only solution
+  std::vector<std::vector<int32_t>> clauses;
+  for (int32_t i = 1; i <= 30; i++) clauses.push_back({i});
+  std::vector<int32_t> weights(30, 1);
+  SatCooling cooling(clauses, weights);
+  CoolingSchedule schedule(50, 0.9, 1e-6, 1e-9, UINT32_MAX, UINT32_MAX, 40);
+  SatConfig start(30);
+  Cooling<SatConfig, SatCriteria, SatCooling> chain(
+      cooling, start, schedule, Rng::fromSeed(6)
+  );
+  ASSERT_TRUE(chain.runSteps(10));
+  ASSERT_FALSE(chain.getBestCriteria().isValid());
+
+  SatConfig migrant(std::vector<bool>(30, true));
+  chain.moveTo(migrant);
+  ASSERT_EQ(chain.getCurrentConfiguration(), migrant);
+  ASSERT_EQ(chain.getBestConfiguration(), migrant);
+  ASSERT_EQ(chain.getBestCriteria().weight(), 30);
+  ASSERT_EQ(chain.getStepsSinceBetterment(), 0);
+  ASSERT_EQ(chain.getStepsTotal(), 10);
+  // Nothing better, the search stays at the migrant until it gives up
+  chain.simulateCooling();
+  ASSERT_EQ(chain.endedBecause(), "gain");
+  ASSERT_EQ(chain.getBestConfiguration(), migrant);
+}
+
+TEST(WSatSolverTest, sharedBestKeepsTheBestPublished) {
+  // Weight w is published with both words of the configuration set to w
+  std::vector<std::vector<int32_t>> clauses{{1}};
+  std::vector<int32_t> weights(128, 1);
+  SatCooling cooling(clauses, weights);
+  SatSharedBest shared(128);
+  ASSERT_FALSE(shared.read());
+  auto publish = [&](uint32_t weight) {
+    SatConfig configuration(128);
+    configuration.words()[0] = weight;
+    configuration.words()[1] = weight;
+    return shared.publish(
+        cooling.satisfiedWithWeight(static_cast<int32_t>(weight)),
+        configuration
+    );
+  };
+  ASSERT_TRUE(publish(5));
+  ASSERT_FALSE(publish(5));
+  ASSERT_FALSE(publish(3));
+  ASSERT_EQ(shared.read()->words()[0], 5);
+  ASSERT_EQ(
+      shared.bestPublishedRank(),
+      SatSharedBest::rank(cooling.satisfiedWithWeight(5))
+  );
+
+  {
+    std::vector<std::jthread> publishers;
+    for (uint32_t t = 0; t < 4; t++) {
+      publishers.emplace_back([&, t] {
+        for (uint32_t weight = 10 + t; weight < 20'000; weight += 4) {
+          publish(weight);
+          // Never a torn copy of two configurations
+          std::optional<SatConfig> seen = shared.read();
+          ASSERT_TRUE(seen);
+          ASSERT_EQ(seen->words()[0], seen->words()[1]);
+        }
+      });
+    }
+  }
+  ASSERT_EQ(shared.read()->words()[0], 19'999);
+}
+
+TEST(WSatSolverTest, cooperatingChainsRestartFromTheShared) {
+  SatCooling cooling(makeInstance());
+  using SatPortfolio = Portfolio<SatConfig, SatCriteria, SatCooling>;
+  CoolingSchedule schedule = makeSchedule();
+
+  SatSharedBest shared(20);
+  SatPortfolio portfolio(4);
+  portfolio.run(
+      Rng::fromSeed(42),
+      [&](uint32_t, Rng rng) {
+        return SatPortfolio::Chain(cooling, schedule, rng);
+      },
+      [&](SatPortfolio::Chain& chain, uint32_t) {
+        runCooperating(chain, shared, 1);
+      }
+  );
+  const SatPortfolio::Chain& best = portfolio.chain(portfolio.bestIndex());
+  ASSERT_TRUE(best.getBestCriteria().isValid());
+  // The shared one is the best of all chains
+  ASSERT_EQ(
+      shared.bestPublishedRank(), SatSharedBest::rank(best.getBestCriteria())
+  );
+  SatCriteria sharedCriteria = cooling.evaluateFully(*shared.read());
+  ASSERT_EQ(sharedCriteria.weight(), best.getBestCriteria().weight());
+  for (uint32_t i = 0; i < portfolio.size(); i++) {
+    const SatPortfolio::Chain& chain = portfolio.chain(i);
+    SatCriteria full = cooling.evaluateFully(chain.getBestConfiguration());
+    ASSERT_EQ(full.weight(), chain.getBestCriteria().weight());
+  }
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "SatConfig.h"
+#include "SatEvaluation.h"
+#include "WSatInstance.h"
+
+/** Random instance with clauses of width 1 to 7 to exercise kernel tails */
+WSatInstance randomInstance(uint32_t variables, uint32_t clauses) {
+  std::mt19937 generator(variables + clauses);
+  std::uniform_int_distribution<int32_t> variable(1, variables);
+  std::uniform_int_distribution<int32_t> width(1, 7);
+  std::bernoulli_distribution negated(0.5);
+
+  std::vector<int32_t> weights(variables);
+  for (uint32_t i = 0; i < variables; i++) weights[i] = i % 17 + 1;
+  std::vector<std::vector<int32_t>> literals(clauses);
+  for (std::vector<int32_t>& clause : literals) {
+    for (int i = width(generator); i > 0; i--) {
+      int32_t id = variable(generator);
+      clause.push_back(negated(generator) ? -id : id);
+    }
+  }
+  return {literals, weights};
+}
+
+/** Random instance of clauses with width distinct variables */
+WSatInstance uniformInstance(
+    uint32_t variables, uint32_t clauses, uint32_t width
+) {
+  std::mt19937 generator(variables * width);
+  std::bernoulli_distribution negated(0.5);
+  std::vector<int32_t> ids(variables);
+  for (uint32_t i = 0; i < variables; i++) ids[i] = i + 1;
+
+  std::vector<int32_t> weights(variables, 3);
+  std::vector<std::vector<int32_t>> literals(clauses);
+  for (std::vector<int32_t>& clause : literals) {
+    std::shuffle(ids.begin(), ids.end(), generator);
+    for (uint32_t i = 0; i < width; i++) {
+      clause.push_back(negated(generator) ? -ids[i] : ids[i]);
+    }
+  }
+  return {literals, weights};
+}
+
+TEST(SatEvaluationTest, kernelsAgree) {
+  WSatInstance instance = randomInstance(203, 1001);
+  std::mt19937 generator(7);
+  std::bernoulli_distribution value(0.5);
+  for (int round = 0; round < 20; round++) {
+    std::vector<bool> values(instance.variableCount());
+    for (uint32_t i = 0; i < values.size(); i++) values[i] = value(generator);
+    SatConfig config(values);
+
+    std::vector<uint32_t> scalar(instance.clauseCount());
+    std::vector<uint32_t> available(instance.clauseCount());
+    uint32_t scalarSatisfied = countTrueLiterals(
+        instance, config, scalar, EvaluationKernel::Scalar
+    );
+    uint32_t availableSatisfied =
+        countTrueLiterals(instance, config, available, availableKernel());
+    EXPECT_EQ(scalarSatisfied, availableSatisfied);
+    EXPECT_EQ(scalar, available);
+    EXPECT_EQ(
+        sumWeights(instance, config, EvaluationKernel::Scalar),
+        sumWeights(instance, config, availableKernel())
+    );
+
+    int32_t expectedWeight = 0;
+    for (uint32_t i = 0; i < values.size(); i++) {
+      if (values[i]) expectedWeight += instance.weights()[i];
+    }
+    EXPECT_EQ(
+        sumWeights(instance, config, EvaluationKernel::Scalar), expectedWeight
+    );
+  }
+}
+
+TEST(SatEvaluationTest, batchMatchesSingleEvaluation) {
+  WSatInstance instance = randomInstance(150, 640);
+  std::mt19937_64 generator(11);
+  SatConfigBatch batch(instance.variableCount());
+  for (uint32_t id = 1; id <= batch.size(); id++) {
+    batch.setLanes(id, generator());
+  }
+
+  std::array<SatCriteria, SatConfigBatch::width> criteria =
+      evaluateBatch(instance, batch);
+  std::vector<uint32_t> counts(instance.clauseCount());
+  for (uint32_t lane = 0; lane < SatConfigBatch::width; lane++) {
+    SatConfig config = batch.extract(lane);
+    EXPECT_EQ(
+        criteria[lane].satisfied(), countTrueLiterals(instance, config, counts)
+    );
+    EXPECT_EQ(criteria[lane].weight(), sumWeights(instance, config));
+  }
+}
+
+TEST(SatEvaluationTest, fixedWidthMatchesReference) {
+  for (uint32_t width : {3u, 5u}) {
+    WSatInstance instance = uniformInstance(67, 333, width);
+    ASSERT_EQ(instance.uniformWidth(), width);
+    std::mt19937 generator(width);
+    std::bernoulli_distribution value(0.5);
+    std::vector<bool> values(instance.variableCount());
+    for (uint32_t i = 0; i < values.size(); i++) values[i] = value(generator);
+    SatConfig config(values);
+
+    std::vector<uint32_t> expected;
+    uint32_t expectedSatisfied = 0;
+    for (const Clause& clause : instance.clauses()) {
+      uint32_t count = 0;
+      for (const Term& term : clause.disjuncts()) {
+        count += term.isPlain() == values[term.id() - 1];
+      }
+      expected.push_back(count);
+      expectedSatisfied += count > 0;
+    }
+
+    for (EvaluationKernel kernel :
+         {EvaluationKernel::Scalar, availableKernel()}) {
+      std::vector<uint32_t> counts(instance.clauseCount());
+      EXPECT_EQ(
+          countTrueLiterals(instance, config, counts, kernel),
+          expectedSatisfied
+      );
+      EXPECT_EQ(counts, expected);
+    }
+  }
+}
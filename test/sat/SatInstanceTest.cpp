@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
+#include <sys/stat.h>
 
+#include <filesystem>
+#include <fstream>
 #include <random>
+#include <sstream>
+#include <thread>
 
 #include "WSatInstance.h"
 #include "dimacsParsing.h"
@@ -77,3 +82,131 @@ w 2 4 1 6 0
 
   EXPECT_EQ(instance.weightTotal(), 13);
 }
+
+TEST(MaxWSatInstanceTest, builderFedByParserMatchesVectors) {
+  std::string example = R"(p mwcnf 5 4
+w 3 1 4 1 5 0
+1 -3 4 0
+-5 2 -5 1 0
+3 0
+-2 4 -1 0)";
+  std::stringstream ss(example);
+  ParsedDimacsFile res = parseDimacsFile(ss);
+  WSatInstance fromVectors(res.clauses, res.weights);
+
+  WSatInstance::Builder builder;
+  parseDimacsText(example, builder);
+  WSatInstance built = std::move(builder).build();
+
+  auto ids = [](std::span<const Term> terms) {
+    std::vector<int32_t> result;
+    for (const Term& term : terms)
+      result.push_back(term.isNegated() ? -term.id() : term.id());
+    return result;
+  };
+  EXPECT_EQ(ids(built.terms()), ids(fromVectors.terms()));
+  EXPECT_EQ(ids(built.clause(1).disjuncts()), (std::vector{1, 2, -5}));
+  EXPECT_TRUE(std::ranges::equal(
+      built.clauseOffsets(), fromVectors.clauseOffsets()
+  ));
+  EXPECT_TRUE(std::ranges::equal(
+      built.occurrences(), fromVectors.occurrences()
+  ));
+  EXPECT_TRUE(std::ranges::equal(
+      built.occurrenceOffsets(), fromVectors.occurrenceOffsets()
+  ));
+  EXPECT_TRUE(std::ranges::equal(built.weights(), fromVectors.weights()));
+  EXPECT_EQ(built.weightTotal(), 14);
+  EXPECT_EQ(built.uniformWidth(), 0);
+}
+
+TEST(MaxWSatInstanceTest, builderRejectsUndeclaredVariables) {
+  for (const char* example : {
+           "p mwcnf 4 2\nw 1 1 1 1 0\n1 -9 0\n2 0\n",
+           "p mwcnf 4 2\nw 1 1 1 1 0\n1 0 2 0\n2 0\n",
+       }) {
+    WSatInstance::Builder builder;
+    EXPECT_THROW(parseDimacsText(example, builder), std::invalid_argument);
+  }
+  EXPECT_THROW(
+      WSatInstance({{1, 2}, {-3}}, std::vector<int32_t>{1, 1}),
+      std::invalid_argument
+  );
+}
+
+TEST(MaxWSatInstanceTest, imageLoadsTheSameInstance) {
+  std::string example = R"(p mwcnf 5 4
+w 3 1 4 1 5 0
+1 -3 4 0
+-5 2 1 0
+3 0
+-2 4 -1 0)";
+  WSatInstance::Builder builder;
+  parseDimacsText(example, builder);
+  WSatInstance built = std::move(builder).build();
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "instance_test.img";
+  {
+    std::ofstream out(path, std::ios::binary);
+    built.writeImage(out);
+  }
+
+  ASSERT_TRUE(WSatInstance::isImage(path));
+  WSatInstance loaded = WSatInstance::loadImage(path);
+  EXPECT_EQ(loaded.variableCount(), 5);
+  EXPECT_EQ(loaded.clauseCount(), 4);
+  EXPECT_EQ(loaded.weightTotal(), 14);
+  EXPECT_EQ(loaded.uniformWidth(), 0);
+  EXPECT_EQ(loaded.inverseWeightTotal(), built.inverseWeightTotal());
+  EXPECT_EQ(loaded.clause(1).disjuncts()[2].id(), 5);
+  EXPECT_TRUE(loaded.clause(1).disjuncts()[2].isNegated());
+  EXPECT_TRUE(
+      std::ranges::equal(loaded.clauseOffsets(), built.clauseOffsets())
+  );
+  EXPECT_TRUE(std::ranges::equal(loaded.occurrences(), built.occurrences()));
+  EXPECT_TRUE(
+      std::ranges::equal(loaded.occurrenceOffsets(), built.occurrenceOffsets())
+  );
+  EXPECT_TRUE(std::ranges::equal(loaded.weights(), built.weights()));
+
+  // Flip a bit of the payload, then cut it short
+  uintmax_t size = std::filesystem::file_size(path);
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(static_cast<std::streamoff>(size) - 8);
+    char byte = 0;
+    file.read(&byte, 1);
+    file.seekp(static_cast<std::streamoff>(size) - 8);
+    file.put(static_cast<char>(byte ^ 1));
+  }
+  EXPECT_THROW((void)WSatInstance::loadImage(path), std::invalid_argument);
+  std::filesystem::resize_file(path, size - 32);
+  EXPECT_THROW((void)WSatInstance::loadImage(path), std::invalid_argument);
+  std::filesystem::remove(path);
+}
+
+TEST(MaxWSatInstanceTest, pipeIsParsedWithoutLookingForImage) {
+  std::string example = R"(p mwcnf 5 4
+w 3 1 4 1 5 0
+1 -3 4 0
+-5 2 1 0
+3 0
+-2 4 -1 0
+)";
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "instance_test.fifo";
+  std::filesystem::remove(path);
+  ASSERT_EQ(mkfifo(path.c_str(), 0600), 0);
+  std::thread writer([&] { std::ofstream(path, std::ios::binary) << example; });
+  // As main loads an instance, the check must leave the header to the parser
+  EXPECT_FALSE(WSatInstance::isImage(path));
+  WSatInstance::Builder builder;
+  parseDimacsFile(path, builder);
+  writer.join();
+  std::filesystem::remove(path);
+  WSatInstance fromPipe = std::move(builder).build();
+
+  EXPECT_EQ(fromPipe.variableCount(), 5);
+  EXPECT_EQ(fromPipe.clauseCount(), 4);
+  EXPECT_EQ(fromPipe.weightTotal(), 14);
+}
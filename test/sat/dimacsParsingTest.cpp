@@ -1,6 +1,12 @@
+#include <fmt/core.h>
 #include <gtest/gtest.h>
+#include <sys/stat.h>
 
+#include <filesystem>
+#include <fstream>
 #include <random>
+#include <sstream>
+#include <thread>
 
 #include "dimacsParsing.h"
 
@@ -115,4 +121,145 @@ w 2 4 1 6 0
   auto weights = std::vector<int32_t>{2, 4, 1, 6};
   EXPECT_EQ(res.weights, weights);
   EXPECT_EQ(res.varCount, 4);
-}
\ No newline at end of file
+}
+TEST(DimacsParserTest, KeepsValidationMessages) {
+  std::string weights = "p mwcnf 3 1\nw 1 2 0\n1 0\n";
+  std::stringstream weightsStream(weights);
+  try {
+    parseDimacsFile(weightsStream);
+    FAIL();
+  } catch (const std::invalid_argument& e) {
+    EXPECT_STREQ(e.what(), "Expected 3 weights, but got 2");
+  }
+
+  std::string clauses = "p mwcnf 1 2\nw 1 0\n1 0\n";
+  std::stringstream clausesStream(clauses);
+  try {
+    parseDimacsFile(clausesStream);
+    FAIL();
+  } catch (const std::invalid_argument& e) {
+    EXPECT_STREQ(e.what(), "Expected 2 clauses, but got 1");
+  }
+
+  EXPECT_THROW(
+      parseDimacsText("p cnf 1 1\nw 1 0\n1 0\n"), std::invalid_argument
+  );
+  EXPECT_THROW(
+      parseDimacsText("p mwcnf 1 1\nw 1 1\n1 0\n"), std::invalid_argument
+  );
+  EXPECT_THROW(
+      parseDimacsText("p mwcnf 1 1\nw 1 0\n1x 0\n"), std::invalid_argument
+  );
+  EXPECT_THROW(
+      parseDimacsText("p mwcnf 1 1\nw 1 0\n9999999999 0\n"), std::out_of_range
+  );
+}
+
+TEST(DimacsParserTest, ToleratesTabsAndCarriageReturns) {
+  const auto res =
+      parseDimacsText("p mwcnf 2 1\r\nw\t3  4 0\r\n\r\n  +1\t-2 0\r\n");
+  EXPECT_EQ(res.varCount, 2);
+  EXPECT_EQ(res.weights, (std::vector<int32_t>{3, 4}));
+  EXPECT_EQ(res.clauses, (std::vector<std::vector<int32_t>>{{1, -2}}));
+}
+
+/** Long enough for the stream parser to split lines between chunks */
+std::string generateLargeInstance(uint32_t variables, uint32_t clauses) {
+  std::mt19937 generator(variables);
+  std::uniform_int_distribution<int32_t> variable(1, variables);
+  std::string text =
+      fmt::format("c generated\np mwcnf {} {}\nw", variables, clauses);
+  for (uint32_t i = 0; i < variables; i++)
+    text += fmt::format(" {}", i % 97 + 1);
+  text += " 0\n";
+  for (uint32_t i = 0; i < clauses; i++) {
+    text += fmt::format(
+        "{} -{} {} 0\n",
+        variable(generator),
+        variable(generator),
+        variable(generator)
+    );
+  }
+  return text;
+}
+
+TEST(DimacsParserTest, StreamMappedAndTextAgree) {
+  std::string text = generateLargeInstance(50'000, 200'000);
+  ASSERT_GT(text.size(), 2u << 20);
+  const auto fromText = parseDimacsText(text);
+
+  std::stringstream ss(text);
+  const auto fromStream = parseDimacsFile(ss);
+  EXPECT_EQ(fromStream.varCount, fromText.varCount);
+  EXPECT_EQ(fromStream.weights, fromText.weights);
+  EXPECT_EQ(fromStream.clauses, fromText.clauses);
+
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "dimacs_parsing_test.mwcnf";
+  std::ofstream(path, std::ios::binary) << text;
+  const auto fromFile = parseDimacsFile(path);
+  std::filesystem::remove(path);
+  EXPECT_EQ(fromFile.varCount, 50'000);
+  EXPECT_EQ(fromFile.weights, fromText.weights);
+  EXPECT_EQ(fromFile.clauses, fromText.clauses);
+  EXPECT_EQ(fromFile.clauses.size(), 200'000);
+}
+
+TEST(DimacsParserTest, RecognizesCompression) {
+  EXPECT_EQ(compressionOf("p mwcnf 1 1"), Compression::none);
+  EXPECT_EQ(compressionOf("\x1f\x8b\x08"), Compression::gzip);
+  EXPECT_EQ(
+      compressionOf(std::string_view("\xfd" "7zXZ\0\0", 7)), Compression::xz
+  );
+  EXPECT_EQ(compressionOf("\x28\xb5\x2f\xfd"), Compression::zstd);
+  EXPECT_EQ(compressionOf(""), Compression::none);
+}
+
+/** Small instance compressed by gzip and by xz */
+const std::string_view gzipped(
+    "\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\x03\x2b\x50\xc8\x2d\x4f\xce\x4b\x53"
+    "\x30\x52\x30\xe2\x2a\x57\x30\x56\x30\x51\x30\xe0\x32\x54\xd0\x35\x02\x52"
+    "\x20\x0c\x00\x64\x83\x76\xb1\x1f\x00\x00\x00",
+    47
+);
+const std::string_view xzipped(
+    "\xfd\x37\x7a\x58\x5a\x00\x00\x01\x69\x22\xde\x36\x02\x00\x21\x01\x16\x00"
+    "\x00\x00\x74\x2f\xe5\xa3\x01\x00\x1e\x70\x20\x6d\x77\x63\x6e\x66\x20\x32"
+    "\x20\x32\x0a\x77\x20\x33\x20\x34\x20\x30\x0a\x31\x20\x2d\x32\x20\x30\x0a"
+    "\x32\x20\x30\x0a\x00\x00\x64\x83\x76\xb1\x00\x01\x33\x1f\xee\xdd\xe5\x59"
+    "\x90\x42\x99\x0d\x01\x00\x00\x00\x00\x01\x59\x5a",
+    84
+);
+
+TEST(DimacsParserTest, DecompressesFiles) {
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "dimacs_parsing_test.z";
+  for (std::string_view compressed : {gzipped, xzipped}) {
+    if (!isSupported(compressionOf(compressed))) continue;
+    std::ofstream(path, std::ios::binary) << compressed;
+    const auto res = parseDimacsFile(path);
+    EXPECT_EQ(res.weights, (std::vector<int32_t>{3, 4}));
+    EXPECT_EQ(res.clauses, (std::vector<std::vector<int32_t>>{{1, -2}, {2}}));
+
+    std::ofstream(path, std::ios::binary)
+        << compressed.substr(0, compressed.size() - 12);
+    EXPECT_THROW(parseDimacsFile(path), std::invalid_argument);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(DimacsParserTest, ReadsPipes) {
+  std::string text = generateLargeInstance(50'000, 200'000);
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "dimacs_parsing_test.fifo";
+  std::filesystem::remove(path);
+  ASSERT_EQ(mkfifo(path.c_str(), 0600), 0);
+  std::thread writer([&] { std::ofstream(path, std::ios::binary) << text; });
+  const auto fromPipe = parseDimacsFile(path);
+  writer.join();
+  std::filesystem::remove(path);
+
+  const auto fromText = parseDimacsText(text);
+  EXPECT_EQ(fromPipe.weights, fromText.weights);
+  EXPECT_EQ(fromPipe.clauses, fromText.clauses);
+}